@@ -0,0 +1,985 @@
+// File: ArrayBox.cpp
+// Author: Tahfizur Rahman 
+// Date: 03/04/2025
+// A source files that defines ArrayBox. It is included at the bottom of ArrayBox.hpp, 
+// since the template has to be visible wherever it is instantiated.
+
+#include "ArrayBox.hpp"
+
+/**
+* @brief Default constructor
+* @post Initializes capacity_ to 64 (or N, if the box has a fixed capacity) and size_ to 0. 
+*      Allocates a dynamic array for items_ of length equal to the capacity_. 
+*/
+template <typename T, int N>
+ArrayBox<T, N>::ArrayBox() : ArrayBox(64) {}
+
+/**
+* @brief Parameterized constructor
+* @param capacity A const reference to an integer describing the maximum capacity of the items_ array.
+*      If capacity is not positive (ie. <= 0), 64 is used instead. A box with a fixed capacity N ignores it and uses N.
+* @post size_ is initialized to 0. items_ is initialized to a dynamically allocated array of length equal to 'capacity'
+*/
+template <typename T, int N>
+ArrayBox<T, N>::ArrayBox(const int& capacity) : ArrayBox(capacity, nullptr) {}
+
+/**
+* @brief Same as the parameterized constructor above, but takes the box's storage from a pool instead of the heap.
+*      Every copy of the box allocates from the same pool, and gives its storage back to it when destroyed.
+* @param capacity A const reference to an integer describing the maximum capacity of the items_ array
+* @param pool The pool to allocate from, which must outlive the box and all its copies. nullptr uses the heap.
+*      A box with a fixed capacity N ignores it, since its storage is inline.
+*/
+template <typename T, int N>
+ArrayBox<T, N>::ArrayBox(const int& capacity, BoxPool* pool) : 
+    capacity_{N > 0 ? N : capacity > 0 ? capacity : 64}, size_{0}, end_{0}, lazy_{false}, compactThreshold_{0.25}, pool_{N > 0 ? nullptr : pool} {
+    allocate();
+    for (int i = 0; i < capacity_; i++) {
+        tags_[i] = EMPTY_TAG;
+        freeSlots_[i] = capacity_ - 1 - i;   // So slot 0 is handed out first
+    }
+    freeSlotCount_ = capacity_;
+}
+
+/**
+* @brief Copy constructor. This is O(1): the copy shares other's items_ array (copy-on-write)
+*      until either box adds, removes, compacts or hands out a non-const reference to an item.
+* @param other A const reference to the ArrayBox to copy
+* @post items_ is shared with other. A box with a fixed capacity N copies every cell instead.
+*/
+template <typename T, int N>
+ArrayBox<T, N>::ArrayBox(const ArrayBox& other) {
+    if constexpr (N > 0) {
+        duplicate(other);
+    } else {
+        share(other);
+    }
+}
+
+/**
+* @brief Copy assignment operator. Like the copy constructor, this shares other's items_ array until either box writes.
+* @param other A const reference to the ArrayBox to copy
+* @post Our share of the old items_ array is released and other's is shared with us (or copied, when N > 0)
+* @return A reference to this ArrayBox
+*/
+template <typename T, int N>
+ArrayBox<T, N>& ArrayBox<T, N>::operator=(const ArrayBox& other) {
+    if (this == &other) { return *this; }
+
+    release();
+    if constexpr (N > 0) {
+        duplicate(other);
+    } else {
+        share(other);
+    }
+    return *this;
+}
+
+/**
+* @brief Move constructor
+* @param other An rvalue reference to the ArrayBox to move from
+* @post We own other's items_ array without copying any items. other is left empty with a capacity of 0.
+*      A box with a fixed capacity N copies every cell instead, and leaves other as it was.
+*      Copying a cell can throw, so only a box with N == 0 moves noexcept.
+*/
+template <typename T, int N>
+ArrayBox<T, N>::ArrayBox(ArrayBox&& other) noexcept(N == 0) {
+    if constexpr (N > 0) {
+        duplicate(other);
+    } else {
+        takeFrom(other);
+    }
+}
+
+/**
+* @brief Move assignment operator
+* @param other An rvalue reference to the ArrayBox to move from
+* @post Our old items_ array is released and replaced with other's. other is left empty with a capacity of 0.
+*      A box with a fixed capacity N copies every cell instead, and leaves other as it was.
+*      Copying a cell can throw, so only a box with N == 0 moves noexcept.
+* @return A reference to this ArrayBox
+*/
+template <typename T, int N>
+ArrayBox<T, N>& ArrayBox<T, N>::operator=(ArrayBox&& other) noexcept(N == 0) {
+    if (this == &other) { return *this; }
+
+    release();
+    if constexpr (N > 0) {
+        duplicate(other);
+    } else {
+        takeFrom(other);
+    }
+    return *this;
+}
+
+/**
+* @brief Destructor
+* @post Releases our share of the dynamically allocated items_ array, freeing it if no copy still shares it
+*/
+template <typename T, int N>
+ArrayBox<T, N>::~ArrayBox() {
+    release();
+}
+
+/**
+ * @brief Allocates items_ and every array parallel to it (or indexed by slot) for capacity_ cells,
+ *      all in one block (see BoxLayout) taken from the inline block, pool_ or the heap
+ * @post We are the only owner of the new arrays
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::allocate() {
+    static_assert(alignof(T) <= BoxPool::ALIGNMENT, "ArrayBox items must fit the alignment of a BoxPool block");
+    size_t bytes = BoxLayout<T>::blockBytes(capacity_);
+    unsigned char* block;
+    if constexpr (N > 0) {
+        block = this->inlineBlock();
+    } else {
+        block = static_cast<unsigned char*>(pool_ != nullptr ? pool_->acquire(bytes) : ::operator new(bytes, std::align_val_t(BoxPool::ALIGNMENT)));
+    }
+
+    items_ = reinterpret_cast<T*>(block);
+    std::uninitialized_value_construct_n(items_, capacity_);
+    owners_ = new (block + BoxLayout<T>::itemsBytes(capacity_)) std::atomic<int>(1);
+
+    int* ints = reinterpret_cast<int*>(block + BoxLayout<T>::itemsBytes(capacity_) + sizeof(std::atomic<int>));
+    freeRun_ = ints;
+    cellSlot_ = ints + capacity_;
+    slotCell_ = ints + 2 * capacity_;
+    slotGeneration_ = ints + 3 * capacity_;
+    freeSlots_ = ints + 4 * capacity_;
+    runNext_ = ints + 5 * capacity_;
+    runPrev_ = ints + 6 * capacity_;
+    tags_ = reinterpret_cast<unsigned char*>(ints + 7 * capacity_);
+    std::fill(freeRun_, freeRun_ + capacity_, 0);
+    std::fill(slotGeneration_, slotGeneration_ + capacity_, 0);
+    freeSlotCount_ = 0;
+    freeHead_ = -1;
+}
+
+/**
+ * @brief Gives up our share of the arrays, giving the block allocate() took back to pool_ (or the heap) if we were the last owner
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::release() {
+    if (owners_ == nullptr || owners_->fetch_sub(1) != 1) { return; }
+
+    std::destroy_n(items_, capacity_);
+    owners_->~atomic();
+    owners_ = nullptr;
+    if constexpr (N > 0) {
+        return;
+    }
+    if (pool_ != nullptr) {
+        pool_->recycle(items_, BoxLayout<T>::blockBytes(capacity_));
+    } else {
+        ::operator delete(items_, std::align_val_t(BoxPool::ALIGNMENT));
+    }
+}
+
+/**
+ * @brief Shares other's arrays and copies the rest of its state, without copying any items. Ours must already be released.
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::share(const ArrayBox& other) {
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+    end_ = other.end_;
+    lazy_ = other.lazy_;
+    compactThreshold_ = other.compactThreshold_;
+    items_ = other.items_;
+    freeRun_ = other.freeRun_;
+    tags_ = other.tags_;
+    cellSlot_ = other.cellSlot_;
+    slotCell_ = other.slotCell_;
+    slotGeneration_ = other.slotGeneration_;
+    freeSlots_ = other.freeSlots_;
+    freeSlotCount_ = other.freeSlotCount_;
+    runNext_ = other.runNext_;
+    runPrev_ = other.runPrev_;
+    freeHead_ = other.freeHead_;
+    typeCount_ = other.typeCount_;
+    firstHint_ = other.firstHint_;
+    owners_ = other.owners_;
+    pool_ = other.pool_;
+    if (owners_ != nullptr) { owners_->fetch_add(1); }
+}
+
+/**
+ * @brief Gives us a private copy of the arrays if they are shared with another box. 
+ *      Called before anything that writes to them.
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::unshare() {
+    if (owners_ == nullptr || owners_->load() == 1) { return; }
+    BOX_STAT(unshares, 1);
+
+    // Step off the shared arrays and fill fresh ones from them. Our share is released when `shared` goes out of scope.
+    ArrayBox shared(std::move(*this));
+    duplicate(shared);
+}
+
+/**
+ * @brief Gives us arrays of our own holding a copy of everything in other's. Ours must already be released.
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::duplicate(const ArrayBox& other) {
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+    end_ = other.end_;
+    lazy_ = other.lazy_;
+    compactThreshold_ = other.compactThreshold_;
+    pool_ = other.pool_;
+    allocate();
+    copyFrom(other);
+}
+
+/**
+ * @brief Copies the contents of other's arrays into ours, which must already have other's capacity
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::copyFrom(const ArrayBox& other) {
+    for (int i = 0; i < capacity_; i++) {
+        items_[i] = other.items_[i];
+        freeRun_[i] = other.freeRun_[i];
+        tags_[i] = other.tags_[i];
+        cellSlot_[i] = other.cellSlot_[i];
+        slotCell_[i] = other.slotCell_[i];
+        slotGeneration_[i] = other.slotGeneration_[i];
+        freeSlots_[i] = other.freeSlots_[i];
+        runNext_[i] = other.runNext_[i];
+        runPrev_[i] = other.runPrev_[i];
+    }
+    freeSlotCount_ = other.freeSlotCount_;
+    freeHead_ = other.freeHead_;
+    typeCount_ = other.typeCount_;
+    firstHint_ = other.firstHint_;
+}
+
+/**
+ * @brief Takes over other's arrays and state without copying any items. Ours must already be released.
+ * @post other is left empty with a capacity of 0. It can still be assigned to or destroyed.
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::takeFrom(ArrayBox& other) {
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+    end_ = other.end_;
+    lazy_ = other.lazy_;
+    compactThreshold_ = other.compactThreshold_;
+    items_ = other.items_;
+    freeRun_ = other.freeRun_;
+    tags_ = other.tags_;
+    cellSlot_ = other.cellSlot_;
+    slotCell_ = other.slotCell_;
+    slotGeneration_ = other.slotGeneration_;
+    freeSlots_ = other.freeSlots_;
+    freeSlotCount_ = other.freeSlotCount_;
+    runNext_ = other.runNext_;
+    runPrev_ = other.runPrev_;
+    freeHead_ = other.freeHead_;
+    typeCount_ = std::move(other.typeCount_);
+    firstHint_ = std::move(other.firstHint_);
+    owners_ = other.owners_;
+    pool_ = other.pool_;
+
+    other.capacity_ = other.size_ = other.end_ = other.freeSlotCount_ = 0;
+    other.items_ = nullptr;
+    other.freeRun_ = nullptr;
+    other.tags_ = nullptr;
+    other.cellSlot_ = other.slotCell_ = other.slotGeneration_ = other.freeSlots_ = nullptr;
+    other.runNext_ = other.runPrev_ = nullptr;
+    other.freeHead_ = -1;
+    other.owners_ = nullptr;
+    other.typeCount_.clear();
+    other.firstHint_.clear();
+}
+
+/**
+ * @return The one-byte tag stored in tags_ for items of the given type ID
+ */
+template <typename T, int N>
+unsigned char ArrayBox<T, N>::tagOf(int typeId) {
+    return (typeId >= 0 && typeId < OVERFLOW_TAG) ? static_cast<unsigned char>(typeId) : OVERFLOW_TAG;
+}
+
+/**
+ * @param index The first cell of an item or free run
+ * @return The first cell of the next item or free run
+ */
+template <typename T, int N>
+int ArrayBox<T, N>::next(int index) const {
+    return index + (freeRun_[index] > 0 ? freeRun_[index] : items_[index].size());
+}
+
+/**
+ * @brief Marks [start, start + length) as a free run and pushes it onto the free list
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::linkRun(int start, int length) {
+    freeRun_[start] = length;
+    if (length > 1) { freeRun_[start + length - 1] = -length; }
+
+    runPrev_[start] = -1;
+    runNext_[start] = freeHead_;
+    if (freeHead_ != -1) { runPrev_[freeHead_] = start; }
+    freeHead_ = start;
+}
+
+/**
+ * @brief Takes the free run starting at the given cell off the free list, and clears its marks in freeRun_
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::unlinkRun(int start) {
+    int length = freeRun_[start];
+    freeRun_[start] = 0;
+    freeRun_[start + length - 1] = 0;
+
+    if (runPrev_[start] != -1) { 
+        runNext_[runPrev_[start]] = runNext_[start]; 
+    } else {
+        freeHead_ = runNext_[start];
+    }
+    if (runNext_[start] != -1) { runPrev_[runNext_[start]] = runPrev_[start]; }
+}
+
+/**
+ * @return The first cell of the first run on the free list with at least the given length, or -1 if none fits
+ */
+template <typename T, int N>
+int ArrayBox<T, N>::findRun(int length) const {
+    int run = freeHead_;
+    while (run != -1 && freeRun_[run] < length) { run = runNext_[run]; }
+    return run;
+}
+
+/**
+ * @return True if typeCount_ and firstHint_ can have an entry for typeId, which is always the case when N == 0
+ */
+template <typename T, int N>
+bool ArrayBox<T, N>::tracks(int typeId) {
+    return N == 0 || typeId < FixedTypeTable<N>::LIMIT;
+}
+
+/**
+ * @brief Grows typeCount_ and firstHint_ so that typeId is a valid index
+ * @pre tracks(typeId)
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::trackType(int typeId) {
+    if (typeId >= static_cast<int>(typeCount_.size())) {
+        typeCount_.resize(typeId + 1, 0);
+        firstHint_.resize(typeId + 1, 0);
+    }
+}
+
+/**
+ * @brief Slides every item left over the free cells in one linear pass, so all items sit in [0, size_).
+ *      The cells after them are reset to default-initialized objects.
+ * @post end_ == size_ and there are no free runs left
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::compact() {
+    unshare();
+
+    // Every item moves, so the hints are rebuilt exactly along the way
+    for (size_t t = 0; t < firstHint_.size(); t++) { firstHint_[t] = -1; }
+
+    int write = 0;
+    for (int read = 0; read < end_; ) {
+        int length = freeRun_[read] > 0 ? freeRun_[read] : items_[read].size();
+        if (freeRun_[read] == 0) {
+            int typeId = items_[read].getTypeId();
+            if (typeId >= 0 && firstHint_[typeId] == -1) { firstHint_[typeId] = write; }
+
+            unsigned char tag = tags_[read];
+            tags_[read] = EMPTY_TAG;
+            tags_[write] = tag;
+            cellSlot_[write] = cellSlot_[read];
+            slotCell_[cellSlot_[write]] = write;
+            if (write != read) { BOX_STAT(cellsShifted, length); }
+            for (int cell = 0; cell < length; cell++) {
+                if (write != read) { items_[write] = items_[read + cell]; }
+                write++;
+            }
+        }
+        read += length;
+    }
+
+    BOX_STAT(defaultsWritten, end_ - write);
+    for (int i = write; i < end_; i++) {
+        items_[i] = T();
+    }
+    // Every free run was slid over, so the free list and the marks at both ends of each run go too
+    std::fill(freeRun_, freeRun_ + end_, 0);
+    freeHead_ = -1;
+    end_ = write;
+
+    for (size_t t = 0; t < firstHint_.size(); t++) {
+        if (firstHint_[t] == -1) { firstHint_[t] = 0; }
+    }
+}
+
+/**
+ *  @brief Searches a subarray of `items_` for an item of the given type. 
+ *      Returns the *leftmost* index of the item if it is found within 
+ *      the subarray from [start, end). Return -1 if not found.
+ * 
+ *  @param type A const reference to a string denoting the `type` of the object to search for
+ *  @param start An integer representing the start of the subarray to search
+ *  @param end An integer representing the end of the subarray to search (non-inclusive)
+ * 
+ *  @return Either the index target in the subarray within items_ as an integer
+ *          or -1, if the subarray does not contain an object of that type
+ *  @note The name is resolved to its type ID once, then the ID overload does the scan.
+**/
+template <typename T, int N>
+int ArrayBox<T, N>::getIndexOf(const std::string& type, int start, int end) const {
+    int typeId = NameRegistry::pieceTypes().find(type);
+    if (typeId == NameRegistry::NOT_FOUND) { return -1; }
+    return getIndexOf(typeId, start, end);
+}
+
+/**
+ *  @brief Same as getIndexOf above, but compares the integer type ID 
+ *      (see NameRegistry::pieceTypes()) of each item instead of its type name.
+ * 
+ *  @param typeId An integer denoting the type ID of the object to search for
+ *  @param start An integer representing the start of the subarray to search
+ *  @param end An integer representing the end of the subarray to search (non-inclusive)
+ * 
+ *  @return Either the index target in the subarray within items_ as an integer
+ *          or -1, if the subarray does not contain an object of that type
+ */
+template <typename T, int N>
+int ArrayBox<T, N>::getIndexOf(int typeId, int start, int end) const {
+    if (start < 0 || start >= end_ || end < 0 || end > end_ || start >= end) { return -1; }
+    if (count(typeId) == 0) { return -1; }
+
+    // Nothing of this type starts before its hint, so a search from the front can begin there
+    start = std::max<int>(start, firstHint_[typeId]);
+
+    // Only the first cell of a live item is tagged, so matching tags are exactly the candidates.
+    // Types sharing OVERFLOW_TAG still have to be confirmed against the item itself.
+    unsigned char tag = tagOf(typeId);
+    BOX_STAT(searches, 1);
+    for (int i = start; i < end; i++) {
+        int found = ScanKernels::find(tags_ + i, end - i, tag);
+        if (found == -1) {
+            BOX_STAT(cellsProbed, end - start);
+            return -1;
+        }
+
+        i += found;
+        if (tag != OVERFLOW_TAG || items_[i].getTypeId() == typeId) {
+            BOX_STAT(cellsProbed, i + 1 - start);
+            return i;
+        }
+    }
+    BOX_STAT(cellsProbed, end - start);
+    return -1;
+}
+
+/**
+ * @brief Appends the parameter item to the `items_` array such that:
+ *  1) There current size_ and target.getSize() is small enough 
+ *      that the item can be added without exceeding the ArrayBox capacity_
+ *  2) The target item takes up target.getSize() spaces at 
+ *      starting at the leftmost non-occupied space
+ * 
+ * @param type A const reference to an item of type T, specifying the object to add
+ * @return A handle to the added item, which tests true if the add was successful and false otherwise.
+ *      A box with a fixed capacity (N > 0) also fails to add an item whose type ID is FixedTypeTable<N>::LIMIT or more.
+ * @post Increment size_ if the item was added.
+ */
+template <typename T, int N>
+BoxHandle ArrayBox<T, N>::addItem(const T& target) {
+    int itemSize = target.size();
+    if (itemSize <= 0 || !tracks(target.getTypeId())) { return BoxHandle(); }
+    if (size_ + itemSize > capacity()) {
+        BOX_STAT(failedAdds, 1);
+        return BoxHandle();
+    }
+    unshare();
+
+    // Lazy deletion may have left free runs below end_. Take the first that fits, leaving the rest of it free.
+    int index = end_;
+    int run = findRun(itemSize);
+    if (run != -1) {
+        int length = freeRun_[run];
+        unlinkRun(run);
+        if (length > itemSize) { linkRun(run + itemSize, length - itemSize); }
+        index = run;
+    } else if (end_ + itemSize > capacity()) {
+        // There is enough room in total, but scattered over runs too short for the item
+        compact();
+        index = end_;
+    }
+
+    for (int i = 0; i < itemSize; i++) {
+        items_[index + i] = target;
+    }
+
+    int typeId = target.getTypeId();
+    tags_[index] = tagOf(typeId);
+    if (typeId >= 0) {
+        trackType(typeId);
+        if (typeCount_[typeId]++ == 0 || index < firstHint_[typeId]) { firstHint_[typeId] = index; }
+    }
+    // Every item takes at least one cell, so there is always a free slot for it
+    int slot = freeSlots_[--freeSlotCount_];
+    slotCell_[slot] = index;
+    cellSlot_[index] = slot;
+
+    size_ += itemSize;
+    end_ = std::max(end_, index + itemSize);
+    return BoxHandle{slot, slotGeneration_[slot]};
+}
+
+/**
+* @brief Removes the first instance in `items_` of an object whose `getType()` equals the parameter given
+*      To maximize contiguous space available to add objects later, we shift 
+*      all elements over by the size of the object we just removed.
+*      
+*      `size_` is also decremented by the size of the object we just removed.
+* 
+*      Instead of lazy-deletion, all values that are not counted as part of the valid subarray, ie. not from indices [0, size_)
+*      are set to a default-initialized object
+* 
+*      If no object of the given type is found, nothing happens.
+*  
+* @param type A const reference to a string specifying the type of the object to remove
+* @return True if the remove operation was successfully performed. False otherwise.
+* @note The name is resolved to its type ID once, then the ID overload does the removal.
+*/
+template <typename T, int N>
+bool ArrayBox<T, N>::remove(const std::string& type) {
+    int typeId = NameRegistry::pieceTypes().find(type);
+    if (typeId == NameRegistry::NOT_FOUND) { return false; }
+    return remove(typeId);
+}
+
+/**
+* @brief Same as remove above, but takes the integer type ID of the object to remove
+* @param typeId An integer denoting the type ID of the object to remove
+* @return True if the remove operation was successfully performed. False otherwise.
+*/
+template <typename T, int N>
+bool ArrayBox<T, N>::remove(int typeId) {
+    int index = getIndexOf(typeId, 0, end_);
+    if (index == -1) { return false; }
+
+    removeAt(index);
+    return true;
+}
+
+/**
+* @brief Removes the item a handle refers to, exactly as remove() would remove it
+* @param handle A handle returned by addItem()
+* @return True if the handle was still valid and its item was removed. False otherwise.
+*/
+template <typename T, int N>
+bool ArrayBox<T, N>::remove(const BoxHandle& handle) {
+    int index = indexOf(handle);
+    if (index == -1) { return false; }
+
+    removeAt(index);
+    return true;
+}
+
+/**
+ * @brief Puts back an item removed through the given handle, so the handle is valid again.
+ *      This is how a removal is undone: the item is added as addItem() would, but keeps its old slot and generation.
+ *      It is O(1) when nothing else has been removed since, which is the case when undoing removals in reverse order.
+ * @param handle The handle the item had before it was removed
+ * @param target A const reference to the item to put back
+ * @return True if the item was put back. False if the handle was never valid, its slot has been reused since, 
+ *      or the box does not have room for the item.
+ */
+template <typename T, int N>
+bool ArrayBox<T, N>::restore(const BoxHandle& handle, const T& target) {
+    // Releasing the slot bumped its generation once. Any later reuse would have bumped it again.
+    int slot = handle.slot;
+    if (slot < 0 || slot >= capacity() || slotGeneration_[slot] != handle.generation + 1) { return false; }
+    if (target.size() <= 0 || size_ + target.size() > capacity() || !tracks(target.getTypeId())) { return false; }
+
+    // The slot is normally still on top of the free stack. Swap it there so addItem() hands it out.
+    int position = freeSlotCount_ - 1;
+    while (position >= 0 && freeSlots_[position] != slot) { position--; }
+    if (position == -1) { return false; }
+
+    unshare();
+    std::swap(freeSlots_[position], freeSlots_[freeSlotCount_ - 1]);
+    addItem(target);
+    slotGeneration_[slot] = handle.generation;
+    return true;
+}
+
+/**
+ * @brief Replaces the item a handle refers to with another item, which may have a different type and size.
+ *      The handle stays valid and refers to the new item, which is added as addItem() would.
+ * @param handle A handle returned by addItem()
+ * @param target A const reference to the item to put in its place
+ * @return True if the item was replaced. False if the handle is no longer valid, or the box does not have room for target.
+ */
+template <typename T, int N>
+bool ArrayBox<T, N>::replace(const BoxHandle& handle, const T& target) {
+    int index = indexOf(handle);
+    if (index == -1 || target.size() <= 0 || size_ - items_[index].size() + target.size() > capacity()) { return false; }
+    if (!tracks(target.getTypeId())) { return false; }
+
+    // Removing releases the slot with its generation bumped once, which is exactly what restore() takes back
+    removeAt(index);
+    return restore(handle, target);
+}
+
+/**
+ * @brief Removes the item starting at the given cell, shifting or freeing cells as remove() describes
+ * @param index The first cell of a live item
+ * @post The item's handle is invalidated
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::removeAt(int index) {
+    unshare();
+
+    int itemSize = items_[index].size();
+    int typeId = items_[index].getTypeId();
+    BOX_STAT(removes, 1);
+    size_ -= itemSize;
+    if (typeId >= 0) { typeCount_[typeId]--; }
+    tags_[index] = EMPTY_TAG;
+
+    // The hint sat on the leftmost item of its type, which is gone, so move it on to the next one.
+    // Lookups are const and never touch the hints, so this keeps every search from the front short.
+    if (typeId >= 0 && firstHint_[typeId] == index && typeCount_[typeId] > 0) {
+        firstHint_[typeId] = getIndexOf(typeId, index, end_);
+    }
+
+    // Bumping the generation invalidates every outstanding handle to this slot
+    int slot = cellSlot_[index];
+    slotGeneration_[slot]++;
+    freeSlots_[freeSlotCount_++] = slot;
+
+    if (lazy_) {
+        // Free the cells in place, merged with the free runs on either side, so no two runs on the free list touch
+        int start = index, length = itemSize;
+        if (start > 0 && freeRun_[start - 1] != 0) {
+            int before = std::abs(freeRun_[start - 1]);
+            start -= before;
+            length += before;
+            unlinkRun(start);
+        }
+        if (index + itemSize < end_ && freeRun_[index + itemSize] > 0) {
+            length += freeRun_[index + itemSize];
+            unlinkRun(index + itemSize);
+        }
+
+        // A run reaching the last cell in use just pulls end_ back instead
+        if (start + length == end_) {
+            end_ = start;
+        } else {
+            linkRun(start, length);
+        }
+        if (end_ - size_ > compactThreshold_ * capacity()) { compact(); }
+        return;
+    }
+
+    BOX_STAT(cellsShifted, std::max(0, end_ - itemSize - index));
+    for (int i = index; i + itemSize < end_; i++) {
+        items_[i] = items_[i + itemSize];
+        tags_[i] = tags_[i + itemSize];
+        if (tags_[i] != EMPTY_TAG) {
+            cellSlot_[i] = cellSlot_[i + itemSize];
+            slotCell_[cellSlot_[i]] = i;
+        }
+    }
+    end_ -= itemSize;
+
+    // Everything after the removed item moved left, and so did the hints pointing there
+    for (size_t t = 0; t < firstHint_.size(); t++) {
+        if (firstHint_[t] > index) { firstHint_[t] -= itemSize; }
+    }
+
+    BOX_STAT(defaultsWritten, itemSize);
+    for (int i = end_; i < end_ + itemSize; i++) {
+        items_[i] = T();
+        tags_[i] = EMPTY_TAG;
+    }
+}
+
+/**
+ * @brief Counts the number of distinct intances of the 
+ *        given type within items_ from indices [0, size_)
+ *        A singular instance of an object is the block of indices from [a, a + a.size())
+ * 
+ * @param type A const reference to a string denoting the type of the item to search for
+ * @return An integer representing the number of 
+ *         distinct instances of objects 
+ *         whose `getType()` is equal to the parameter.
+ */
+template <typename T, int N>
+int ArrayBox<T, N>::count(const std::string& type) const {
+    int typeId = NameRegistry::pieceTypes().find(type);
+    if (typeId == NameRegistry::NOT_FOUND) { return 0; }
+    return count(typeId);
+}
+
+/**
+ * @brief Same as count above, but takes the integer type ID of the item to search for
+ * @param typeId An integer denoting the type ID of the item to search for
+ * @return The number of distinct instances of objects whose `getTypeId()` is equal to the parameter.
+ */
+template <typename T, int N>
+int ArrayBox<T, N>::count(int typeId) const {
+    if (typeId < 0 || typeId >= static_cast<int>(typeCount_.size())) { return 0; }
+    return typeCount_[typeId];
+}
+
+/**
+ * @brief Counts the items of the given type whose first cell lies in [start, end).
+ *      Like getIndexOf, this scans the one-byte type tags with ScanKernels, 
+ *      and only the first cell of an item is tagged, so an N-cell item is counted once.
+ * 
+ *  @param typeId An integer denoting the type ID of the items to count
+ *  @param start An integer representing the start of the subarray to search
+ *  @param end An integer representing the end of the subarray to search (non-inclusive)
+ *  @return The number of such items, or 0 if the range is invalid (see getIndexOf)
+ */
+template <typename T, int N>
+int ArrayBox<T, N>::count(int typeId, int start, int end) const {
+    if (start < 0 || start >= end_ || end < 0 || end > end_ || start >= end) { return 0; }
+    if (count(typeId) == 0) { return 0; }
+
+    unsigned char tag = tagOf(typeId);
+    if (tag != OVERFLOW_TAG) { return ScanKernels::count(tags_ + start, end - start, tag); }
+
+    int total = 0;
+    for (int i = getIndexOf(typeId, start, end); i != -1; i = getIndexOf(typeId, i + 1, end)) { total++; }
+    return total;
+}
+
+/**
+ * @param type A const reference to a string denoting the type of the item to search for
+ * @return True if items_ contains an object whose getType() equals the given parameter
+ * @note The name is resolved to its type ID once, then the ID overload answers in O(1).
+ */
+template <typename T, int N>
+bool ArrayBox<T, N>::contains(const std::string& type) const {
+    int typeId = NameRegistry::pieceTypes().find(type);
+    if (typeId == NameRegistry::NOT_FOUND) { return false; }
+    return contains(typeId);
+}
+
+/**
+ * @param typeId An integer denoting the type ID of the item to search for
+ * @return True if items_ contains an object whose getTypeId() equals the given parameter
+ */
+template <typename T, int N>
+bool ArrayBox<T, N>::contains(int typeId) const {
+    return count(typeId) > 0;
+}
+
+/**
+ * @brief Finds the leftmost item of the given type from the given index to the end of the box
+ * @param typeId An integer denoting the type ID of the item to search for
+ * @param start The index of the first cell of an item to start searching from. Default 0.
+ * @return The index of the item within items_, or -1 if there is none
+ */
+template <typename T, int N>
+int ArrayBox<T, N>::find(int typeId, int start) const {
+    return getIndexOf(typeId, start, end_);
+}
+
+/**
+ * @param handle A handle returned by addItem()
+ * @return The first cell of the item the handle refers to, or -1 if the handle is no longer valid
+ */
+template <typename T, int N>
+int ArrayBox<T, N>::indexOf(const BoxHandle& handle) const {
+    if (handle.slot < 0 || handle.slot >= capacity() || slotGeneration_[handle.slot] != handle.generation) { return -1; }
+    return slotCell_[handle.slot];
+}
+
+/**
+ * @param handle A handle returned by addItem()
+ * @return A pointer to the item the handle refers to, or nullptr if the handle is no longer valid
+ */
+template <typename T, int N>
+const T* ArrayBox<T, N>::get(const BoxHandle& handle) const {
+    int index = indexOf(handle);
+    return index == -1 ? nullptr : &items_[index];
+}
+
+template <typename T, int N>
+T* ArrayBox<T, N>::get(const BoxHandle& handle) {
+    int index = indexOf(handle);
+    if (index == -1) { return nullptr; }
+
+    unshare();
+    return &items_[index];
+}
+
+/**
+ * @param index The first cell of an item (eg. one returned by find())
+ * @return A handle to that item, or an invalid handle if no item starts there
+ */
+template <typename T, int N>
+BoxHandle ArrayBox<T, N>::handleAt(int index) const {
+    if (index < 0 || index >= end_ || tags_[index] == EMPTY_TAG) { return BoxHandle(); }
+    int slot = cellSlot_[index];
+    return BoxHandle{slot, slotGeneration_[slot]};
+}
+
+/**
+ * @brief Removes every item, keeping the box's storage so it can be refilled without allocating.
+ *      Lazy deletion stays as it was set. Every handle handed out before is invalidated, 
+ *      including ones restore() could otherwise have put back.
+ * @post size() == 0. If the storage was shared with a copy, the box first takes its own (see the copy constructor).
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::reset() {
+    if (owners_ == nullptr) { return; }
+    unshare();
+
+    BOX_STAT(defaultsWritten, end_);
+    for (int i = 0; i < end_; i++) {
+        items_[i] = T();
+        tags_[i] = EMPTY_TAG;
+        freeRun_[i] = 0;
+    }
+    // A live item's handle is one generation behind what restore() accepts, so every slot moves two ahead
+    for (int i = 0; i < capacity(); i++) {
+        slotGeneration_[i] += 2;
+        freeSlots_[i] = capacity() - 1 - i;
+    }
+    freeSlotCount_ = capacity();
+    freeHead_ = -1;
+    std::fill(typeCount_.begin(), typeCount_.end(), 0);
+    std::fill(firstHint_.begin(), firstHint_.end(), 0);
+    size_ = end_ = 0;
+}
+
+/**
+ * @brief Turns lazy deletion on or off.
+ *      With lazy deletion, remove() marks the removed item's cells as free in O(1) instead of shifting
+ *      everything after it. The free cells are only reclaimed by compacting the box, which happens when
+ *      the free cells below the last item exceed `threshold` of the capacity, or when addItem() runs out of
+ *      room at the end but the box has enough free cells in total. size() and count() are unaffected.
+ * 
+ * @param enabled True to turn lazy deletion on. Turning it off compacts the box right away.
+ * @param threshold The fraction of the capacity, in (0, 1], that may be left free before compacting. 
+ *      Values outside that range use the default of 0.25.
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::setLazyDeletion(bool enabled, double threshold) {
+    lazy_ = enabled;
+    compactThreshold_ = (threshold > 0 && threshold <= 1) ? threshold : 0.25;
+    if (!lazy_ && end_ != size_) { compact(); }
+}
+
+/**
+ * @return True if lazy deletion is turned on
+ */
+template <typename T, int N>
+bool ArrayBox<T, N>::isLazyDeletion() const {
+    return lazy_;
+}
+
+/**
+ * @brief Compacts the box in one linear pass, sliding every item left over the free runs lazy deletion left behind, 
+ *      so all the free cells are at the end again. Does nothing if there are no free runs.
+ * @post Handles stay valid, but cell indices (eg. from find()) taken before may not
+ */
+template <typename T, int N>
+void ArrayBox<T, N>::defragment() {
+    if (end_ != size_) { compact(); }
+}
+
+/**
+ * @brief Accesses the item whose first cell is at the given index (eg. one returned by find())
+ * @param index An index in [0, size_). It is not bounds checked.
+ * @return A reference to the item
+ */
+template <typename T, int N>
+const T& ArrayBox<T, N>::at(int index) const {
+    return items_[index];
+}
+
+template <typename T, int N>
+T& ArrayBox<T, N>::at(int index) {
+    unshare();
+    return items_[index];
+}
+
+/**
+ * @brief Calls the given function once for every item in the box, from left to right.
+ *      Multi-cell items are visited once, and cells freed by lazy deletion are skipped.
+ * @param function A callable taking a const reference to an item
+ */
+template <typename T, int N>
+template <typename Function>
+void ArrayBox<T, N>::forEach(Function&& function) const {
+    for (const T& item : *this) {
+        function(item);
+    }
+}
+
+/**
+ * @return An iterator to the leftmost item, so a box can be walked with a range-based for loop
+ */
+template <typename T, int N>
+typename ArrayBox<T, N>::const_iterator ArrayBox<T, N>::begin() const {
+    return const_iterator(this, 0);
+}
+
+/**
+ * @return An iterator one past the last item
+ */
+template <typename T, int N>
+typename ArrayBox<T, N>::const_iterator ArrayBox<T, N>::end() const {
+    return const_iterator(this, end_);
+}
+
+/**
+ * @brief Creates an iterator at the first item starting at or after the given cell
+ * @param box The box to iterate over
+ * @param index The first cell of an item or free run, or box->end_
+ */
+template <typename T, int N>
+ArrayBox<T, N>::const_iterator::const_iterator(const ArrayBox* box, int index) : box_{box}, index_{index} {
+    while (index_ < box_->end_ && box_->freeRun_[index_] > 0) { index_ = box_->next(index_); }
+}
+
+/**
+ * @brief Advances to the next item, skipping the rest of this item's cells and any free runs
+ */
+template <typename T, int N>
+typename ArrayBox<T, N>::const_iterator& ArrayBox<T, N>::const_iterator::operator++() {
+    *this = const_iterator(box_, box_->next(index_));
+    return *this;
+}
+
+template <typename T, int N>
+typename ArrayBox<T, N>::const_iterator ArrayBox<T, N>::const_iterator::operator++(int) {
+    const_iterator old = *this;
+    ++*this;
+    return old;
+}
+
+/**
+* Getter for the size member
+* @return Returns the integer value stored in size_
+*/
+template <typename T, int N>
+int ArrayBox<T, N>::size() const {
+    return size_;
+}
+
+/**
+* Getter for the capacity member
+* @return Returns the integer value stored in capacity_, which is the constant N for a box with a fixed capacity,
+*      so checks against it are resolved at compile time
+*/
+template <typename T, int N>
+int ArrayBox<T, N>::capacity() const {
+    return N > 0 ? N : capacity_;
+}
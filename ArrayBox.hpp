@@ -5,13 +5,266 @@
 // A header files that defines ArrayBox
 
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "BoxPool.hpp"
+#include "BoxStats.hpp"
+#include "NameRegistry.hpp"
+#include "ScanKernels.hpp"
+
+/**
+ * @struct BoxHandle
+ * @brief A stable reference to an item in an ArrayBox, returned by addItem().
+ * 
+ * The slot never changes while the item is in the box, even when other removals or compaction move it.
+ * Removing the item bumps the slot's generation, so any handle still holding the old generation
+ * is detected as stale instead of silently referring to whichever item reuses the slot.
+ */
+struct BoxHandle {
+    int slot = -1;         // The index of the item's slot in the box's slot table
+    int generation = 0;    // The generation of the slot when the handle was handed out
+
+    /**
+     * @return True if the handle came from a successful add (it may still have gone stale since)
+     */
+    explicit operator bool() const { return slot != -1; }
+
+    bool operator==(const BoxHandle& other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const BoxHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @struct BoxLayout
+ * @brief Where an ArrayBox's arrays sit within its single block: items_ first, since it has the strictest alignment, 
+ *      then the copy-on-write owner count, the seven int arrays and the one-byte tags.
+ */
+template <typename T>
+struct BoxLayout {
+    /**
+     * @return The bytes taken by items_, rounded up so the owner count after it is aligned
+     */
+    static constexpr size_t itemsBytes(int capacity) {
+        return (sizeof(T) * capacity + alignof(std::atomic<int>) - 1) / alignof(std::atomic<int>) * alignof(std::atomic<int>);
+    }
+
+    /**
+     * @return The size of the whole block for the given capacity
+     */
+    static constexpr size_t blockBytes(int capacity) {
+        return itemsBytes(capacity) + sizeof(std::atomic<int>) + 7 * sizeof(int) * capacity + capacity;
+    }
+};
+
+/**
+ * @struct InlineBlock
+ * @brief The block of an ArrayBox with a fixed capacity N, stored inside the box itself.
+ *      Boxes with a capacity chosen at run time (N == 0) have none, and take their block from the heap or a BoxPool.
+ */
+template <typename T, int N>
+struct InlineBlock {
+    alignas(T) alignas(std::atomic<int>) unsigned char bytes[BoxLayout<T>::blockBytes(N)];
+    unsigned char* inlineBlock() { return bytes; }
+};
 
 template <typename T>
-class ArrayBox {
+struct InlineBlock<T, 0> {
+    unsigned char* inlineBlock() { return nullptr; }
+};
+
+/**
+ * @class FixedTypeTable
+ * @brief The per-type counts and hints of an ArrayBox with a fixed capacity N: the part of std::vector<int> 
+ *      the box uses, kept in a fixed array with an entry for every type ID that has a tag of its own, so an inline box 
+ *      never allocates. Only the entries up to the largest type ID seen so far are in use, and only those are copied.
+ * @tparam N The box's capacity. Counts and hints never exceed it, so each entry is the smallest integer that holds N.
+ */
+template <int N>
+class FixedTypeTable {
+    public:
+        static const int LIMIT = 0xFE;   // One past the largest type ID with an entry (ArrayBox's OVERFLOW_TAG)
+
+        using Value = typename std::conditional<(N <= INT8_MAX), int8_t,
+            typename std::conditional<(N <= INT16_MAX), int16_t, int>::type>::type;
+
+        FixedTypeTable() = default;
+        FixedTypeTable(const FixedTypeTable& other) : size_(other.size_) { std::copy(other.begin(), other.end(), values_); }
+        FixedTypeTable& operator=(const FixedTypeTable& other) {
+            size_ = other.size_;
+            std::copy(other.begin(), other.end(), values_);
+            return *this;
+        }
+
+        size_t size() const { return size_; }
+        Value& operator[](size_t index) { return values_[index]; }
+        int operator[](size_t index) const { return values_[index]; }
+        Value* begin() { return values_; }
+        Value* end() { return values_ + size_; }
+        const Value* begin() const { return values_; }
+        const Value* end() const { return values_ + size_; }
+
+        /**
+         * @pre size <= LIMIT
+         */
+        void resize(size_t size, int value) {
+            if (size > size_) { std::fill(values_ + size_, values_ + size, value); }
+            size_ = size;
+        }
+        void clear() { size_ = 0; }
+
+    private:
+        Value values_[LIMIT];
+        size_t size_ = 0;
+};
+
+/**
+ * @class ArrayBox
+ * @tparam T The item type, which needs getTypeId() and size() members
+ * @tparam N The capacity, fixed at compile time, of a box that keeps its items inline with no allocation at all 
+ *      (so an array of such boxes is one contiguous object). 0, the default, chooses the capacity at run time.
+ * 
+ * A fixed-capacity box can not share its items with a copy, so copying or moving it copies every cell (O(N)),
+ * and moving leaves the source as it was. It also counts its items by type in a FixedTypeTable, 
+ * so it refuses items whose type ID is FixedTypeTable<N>::LIMIT or more.
+ */
+template <typename T, int N = 0>
+class ArrayBox : private InlineBlock<T, N> {
+    static_assert(N >= 0, "An ArrayBox's fixed capacity can not be negative");
+
     private:
         int capacity_;   // Represents the max number of spaces allocated to our array
         int size_;      // Represents the number of spaces currently occupied in our array
+        int end_;       // One past the last cell in use. Equal to size_, unless lazy deletion left free cells behind.
+
+        bool lazy_;                 // Whether remove() frees cells in place instead of shifting (see setLazyDeletion)
+        double compactThreshold_;   // The fraction of capacity_ that may be free cells below end_ before compacting
+        int* freeRun_;              // freeRun_[i] > 0 means a run of that many free cells starts at i. Parallel to items_.
+                                    // The last cell of a longer run holds minus its length, so a run can be found from its end.
+
+        // The free runs form a doubly linked free list, threaded through their first cells, that addItem() searches first-fit
+        int* runNext_;              // runNext_[i] is the first cell of the run after the one starting at i, or -1
+        int* runPrev_;              // runPrev_[i] is the first cell of the run before the one starting at i, or -1
+        int freeHead_;              // The first cell of the first run on the free list, or -1 if there are no free runs
+
+        /**
+         * @brief Marks [start, start + length) as a free run and pushes it onto the free list
+         */
+        void linkRun(int start, int length);
+
+        /**
+         * @brief Takes the free run starting at the given cell off the free list, and clears its marks in freeRun_
+         */
+        void unlinkRun(int start);
+
+        /**
+         * @return The first cell of the first run on the free list with at least the given length, or -1 if none fits
+         */
+        int findRun(int length) const;
+
+        static const unsigned char EMPTY_TAG = 0xFF;      // The tag of every cell that does not start a live item
+        static const unsigned char OVERFLOW_TAG = 0xFE;   // The tag shared by every type ID that does not fit below it
+        unsigned char* tags_;       // tags_[i] is tagOf() the type of the item starting at cell i. Parallel to items_.
+
+        /**
+         * @return The one-byte tag stored in tags_ for items of the given type ID
+         */
+        static unsigned char tagOf(int typeId);
+
+        // Handles: every live item owns a slot, and the slot table says where the item currently starts.
+        int* cellSlot_;         // cellSlot_[i] is the slot of the item starting at cell i. Parallel to items_.
+        int* slotCell_;         // slotCell_[s] is the first cell of the item owning slot s
+        int* slotGeneration_;   // slotGeneration_[s] is bumped every time slot s is released
+        int* freeSlots_;        // A stack of the slots not owned by any item
+        int freeSlotCount_;     // The number of slots on the freeSlots_ stack
+
+        // Copy-on-write: copies share items_ and every array above until one of them writes to its box
+        std::atomic<int>* owners_;   // The number of boxes sharing our arrays, or nullptr if we have none
+
+        BoxPool* pool_;   // The pool our arrays come from, or nullptr to use the heap. Always nullptr when N > 0.
+
+        /**
+         * @brief Allocates items_ and every array parallel to it (or indexed by slot) for capacity_ cells,
+         *      all in one block (see BoxLayout) taken from the inline block, pool_ or the heap
+         * @post We are the only owner of the new arrays
+         */
+        void allocate();
+
+        /**
+         * @brief Gives up our share of the arrays, releasing everything allocate() allocated if we were the last owner
+         */
+        void release();
+
+        /**
+         * @brief Shares other's arrays and copies the rest of its state, without copying any items. Ours must already be released.
+         */
+        void share(const ArrayBox& other);
+
+        /**
+         * @brief Gives us a private copy of the arrays if they are shared with another box. 
+         *      Called before anything that writes to them.
+         */
+        void unshare();
+
+        /**
+         * @brief Gives us arrays of our own holding a copy of everything in other's. Ours must already be released.
+         */
+        void duplicate(const ArrayBox& other);
+
+        /**
+         * @brief Copies the contents of other's arrays into ours, which must already have other's capacity
+         */
+        void copyFrom(const ArrayBox& other);
+
+        /**
+         * @brief Takes over other's arrays and state without copying any items. Ours must already be released.
+         * @post other is left empty with a capacity of 0. It can still be assigned to or destroyed.
+         */
+        void takeFrom(ArrayBox& other);
+
+        /**
+         * @brief Removes the item starting at the given cell, shifting or freeing cells as remove() describes
+         * @param index The first cell of a live item
+         * @post The item's handle is invalidated
+         */
+        void removeAt(int index);
+
+        // Grows with the largest type ID seen when the capacity is chosen at run time, and never allocates when it is fixed
+        using TypeTable = typename std::conditional<N == 0, std::vector<int>, FixedTypeTable<N>>::type;
+        TypeTable typeCount_;            // typeCount_[t] is the number of items with type ID t
+        TypeTable firstHint_;            // firstHint_[t] is the first cell of an item or free run at or before the leftmost item of type t
+
+        /**
+         * @return True if typeCount_ and firstHint_ can have an entry for typeId, which is always the case when N == 0
+         */
+        static bool tracks(int typeId);
+
+        /**
+         * @brief Grows typeCount_ and firstHint_ so that typeId is a valid index
+         * @pre tracks(typeId)
+         */
+        void trackType(int typeId);
+
+        /**
+         * @param index The first cell of an item or free run
+         * @return The first cell of the next item or free run
+         */
+        int next(int index) const;
+
+        /**
+         * @brief Slides every item left over the free cells in one linear pass, so all items sit in [0, size_).
+         *      The cells after them are reset to default-initialized objects.
+         * @post end_ == size_ and there are no free runs left
+         */
+        void compact();
 
     protected:
         T* items_;       // Dynamically allocated array to hold the elements.
@@ -34,13 +287,61 @@ class ArrayBox {
          *  b) If `end` is negative or > size_
          *  c) If `start` >= `end`
             The search is fails to execute, and -1 is returned.
+            (With lazy deletion enabled, the bound is the end of the cells in use rather than size_.)
         **/
         int getIndexOf(const std::string& type, int start, int end) const;
 
+        /**
+         *  @brief Same as getIndexOf above, but compares the integer type ID 
+         *      (see NameRegistry::pieceTypes()) of each item instead of its type name.
+         * 
+         *  @param typeId An integer denoting the type ID of the object to search for
+         *  @param start An integer representing the start of the subarray to search
+         *  @param end An integer representing the end of the subarray to search (non-inclusive)
+         * 
+         *  @return Either the index target in the subarray within items_ as an integer
+         *          or -1, if the subarray does not contain an object of that type
+         */
+        int getIndexOf(int typeId, int start, int end) const;
+
     public:
+        /**
+         * @class const_iterator
+         * @brief A read-only forward iterator over the items of an ArrayBox, from left to right.
+         *      Like forEach(), it visits multi-cell items once and skips cells freed by lazy deletion.
+         *      Adding or removing items invalidates it.
+         */
+        class const_iterator {
+            private:
+                const ArrayBox* box_;   // The box being iterated over
+                int index_;             // The first cell of the current item, or box_->end_ once past the last one
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const T*;
+                using reference = const T&;
+
+                const_iterator(const ArrayBox* box, int index);
+
+                /**
+                 * @return The first cell of the current item within the box, eg. for at() or handleAt()
+                 */
+                int index() const { return index_; }
+
+                const T& operator*() const { return box_->items_[index_]; }
+                const T* operator->() const { return &box_->items_[index_]; }
+                const_iterator& operator++();
+                const_iterator operator++(int);
+
+                bool operator==(const const_iterator& other) const { return index_ == other.index_ && box_ == other.box_; }
+                bool operator!=(const const_iterator& other) const { return !(*this == other); }
+        };
+
         /**
         * @brief Default constructor
-        * @post Initializes capacity_ to 64 and size_ to 0. 
+        * @post Initializes capacity_ to 64 (or N, if the box has a fixed capacity) and size_ to 0. 
         *      Allocates a dynamic array for items_ of length equal to the capacity_. 
         */
         ArrayBox();
@@ -48,11 +349,66 @@ class ArrayBox {
         /**
         * @brief Parameterized constructor
         * @param capacity A const reference to an integer describing the maximum capacity of the items_ array.
-        *      If capacity is not positive (ie. <= 0), 64 is used instead.
+        *      If capacity is not positive (ie. <= 0), 64 is used instead. A box with a fixed capacity N ignores it and uses N.
         * @post size_ is initialized to 0. items_ is initialized to a dynamically allocated array of length equal to 'capacity'
+        * @note The box keeps a count of each type and a hint to where its leftmost item starts, 
+        *      so count() and contains() are O(1), and getIndexOf() skips straight to the hint.
+        *      It also keeps a one-byte type tag per cell, which getIndexOf() scans with SIMD compares.
         */
         ArrayBox(const int& capacity);
 
+        /**
+        * @brief Same as the parameterized constructor above, but takes the box's storage from a pool instead of the heap.
+        *      Every copy of the box allocates from the same pool, and gives its storage back to it when destroyed.
+        * @param capacity A const reference to an integer describing the maximum capacity of the items_ array
+        * @param pool The pool to allocate from, which must outlive the box and all its copies. nullptr uses the heap.
+        *      A box with a fixed capacity N ignores it, since its storage is inline.
+        */
+        ArrayBox(const int& capacity, BoxPool* pool);
+
+        /**
+        * @brief Copy constructor. This is O(1): the copy shares other's items_ array (copy-on-write)
+        *      until either box adds, removes, compacts or hands out a non-const reference to an item.
+        * @param other A const reference to the ArrayBox to copy
+        * @post items_ is shared with other. A box with a fixed capacity N copies every cell instead.
+        * @note A non-const reference taken from at() or get() before copying the box still points into the shared array,
+        *      so take it again after copying.
+        */
+        ArrayBox(const ArrayBox& other);
+
+        /**
+        * @brief Copy assignment operator. Like the copy constructor, this shares other's items_ array until either box writes.
+        * @param other A const reference to the ArrayBox to copy
+        * @post Our share of the old items_ array is released and other's is shared with us (or copied, when N > 0)
+        * @return A reference to this ArrayBox
+        */
+        ArrayBox& operator=(const ArrayBox& other);
+
+        /**
+        * @brief Move constructor
+        * @param other An rvalue reference to the ArrayBox to move from
+        * @post We own other's items_ array without copying any items. other is left empty with a capacity of 0.
+        *      A box with a fixed capacity N copies every cell instead, and leaves other as it was.
+        *      Copying a cell can throw, so only a box with N == 0 moves noexcept.
+        */
+        ArrayBox(ArrayBox&& other) noexcept(N == 0);
+
+        /**
+        * @brief Move assignment operator
+        * @param other An rvalue reference to the ArrayBox to move from
+        * @post Our old items_ array is released and replaced with other's. other is left empty with a capacity of 0.
+        *      A box with a fixed capacity N copies every cell instead, and leaves other as it was.
+        *      Copying a cell can throw, so only a box with N == 0 moves noexcept.
+        * @return A reference to this ArrayBox
+        */
+        ArrayBox& operator=(ArrayBox&& other) noexcept(N == 0);
+
+        /**
+        * @brief Destructor
+        * @post Releases our share of the dynamically allocated items_ array, freeing it if no copy still shares it
+        */
+        ~ArrayBox();
+
         /**
          * @brief Appends the parameter item to the `items_` array such that:
          *  1) There current size_ and target.getSize() is small enough 
@@ -61,8 +417,12 @@ class ArrayBox {
          *      starting at the leftmost non-occupied space
          * 
          * @param type A const reference to an item of type T, specifying the object to add
-         * @return True if the add was successful. False otherwise.
+         * @return A handle to the added item, which tests true if the add was successful and false otherwise.
+         *      A box with a fixed capacity (N > 0) also fails to add an item whose type ID is FixedTypeTable<N>::LIMIT or more.
+         *      The handle stays valid until that item is removed, no matter how other items move.
          * @post Increment size_ if the item was added.
+         * @note With lazy deletion enabled, the item goes into the first free run on the free list that is long enough,
+         *      and only falls back to the end of the box (compacting it if need be) when none is.
          * 
          * @example Given the following instructions, and a length 8 Object array:
                 ArrayBox<ChessPiece> box(capacity=8);
@@ -78,7 +438,7 @@ class ArrayBox {
                 size = 7
             After this, when we tried addItem(Rook), the add would fail.
         */
-        bool addItem(const T& target);
+        BoxHandle addItem(const T& target);
 
         /**
         * @brief Removes the first instance in `items_` of an object whose `getType()` equals the parameter given
@@ -99,6 +459,9 @@ class ArrayBox {
         * 
         * @return True if the remove operation was successfully performed. False otherwise.
         * 
+        * @note With lazy deletion enabled (see setLazyDeletion), the removed item's cells are 
+        *       instead marked free in place, merged with any free run next to them, and nothing is shifted or rewritten.
+        * 
         * @example Given the resuls from the previous example, 
         *       Before: "PAWN ROOK ROOK QUEEN QUEEN QUEEN PAWN NONE"
         *       After removing `QUEEN`: "PAWN ROOK ROOK PAWN NONE NONE NONE NONE"
@@ -106,6 +469,59 @@ class ArrayBox {
         */
         bool remove(const std::string& type);
 
+        /**
+        * @brief Same as remove above, but takes the integer type ID of the object to remove
+        * @param typeId An integer denoting the type ID of the object to remove
+        * @return True if the remove operation was successfully performed. False otherwise.
+        */
+        bool remove(int typeId);
+
+        /**
+        * @brief Removes the item a handle refers to, exactly as remove() would remove it
+        * @param handle A handle returned by addItem()
+        * @return True if the handle was still valid and its item was removed. False otherwise.
+        */
+        bool remove(const BoxHandle& handle);
+
+        /**
+         * @brief Puts back an item removed through the given handle, so the handle is valid again.
+         *      This is how a removal is undone: the item is added as addItem() would, but keeps its old slot and generation.
+         *      It is O(1) when nothing else has been removed since, which is the case when undoing removals in reverse order.
+         * @param handle The handle the item had before it was removed
+         * @param target A const reference to the item to put back
+         * @return True if the item was put back. False if the handle was never valid, its slot has been reused since, 
+         *      or the box does not have room for the item.
+         */
+        bool restore(const BoxHandle& handle, const T& target);
+
+        /**
+         * @brief Replaces the item a handle refers to with another item, which may have a different type and size.
+         *      The handle stays valid and refers to the new item, which is added as addItem() would.
+         * @param handle A handle returned by addItem()
+         * @param target A const reference to the item to put in its place
+         * @return True if the item was replaced. False if the handle is no longer valid, or the box does not have room for target.
+         */
+        bool replace(const BoxHandle& handle, const T& target);
+
+        /**
+         * @param handle A handle returned by addItem()
+         * @return The first cell of the item the handle refers to, or -1 if the handle is no longer valid
+         */
+        int indexOf(const BoxHandle& handle) const;
+
+        /**
+         * @param handle A handle returned by addItem()
+         * @return A pointer to the item the handle refers to, or nullptr if the handle is no longer valid
+         */
+        const T* get(const BoxHandle& handle) const;
+        T* get(const BoxHandle& handle);
+
+        /**
+         * @param index The first cell of an item (eg. one returned by find())
+         * @return A handle to that item, or an invalid handle if no item starts there
+         */
+        BoxHandle handleAt(int index) const;
+
         /**
          * @brief Counts the number of distinct intances of the 
          *        given type within items_ from indices [0, size_)
@@ -123,12 +539,112 @@ class ArrayBox {
          */
         int count(const std::string& type) const;
 
+        /**
+         * @brief Same as count above, but takes the integer type ID of the item to search for
+         * @param typeId An integer denoting the type ID of the item to search for
+         * @return The number of distinct instances of objects whose `getTypeId()` is equal to the parameter.
+         */
+        int count(int typeId) const;
+
+        /**
+         * @brief Counts the items of the given type whose first cell lies in [start, end).
+         *      Like getIndexOf, this scans the one-byte type tags with ScanKernels, 
+         *      and only the first cell of an item is tagged, so an N-cell item is counted once.
+         * 
+         *  @param typeId An integer denoting the type ID of the items to count
+         *  @param start An integer representing the start of the subarray to search
+         *  @param end An integer representing the end of the subarray to search (non-inclusive)
+         *  @return The number of such items, or 0 if the range is invalid (see getIndexOf)
+         */
+        int count(int typeId, int start, int end) const;
+
         /**
          * @param type A const reference to a string denoting the type of the item to search for
          * @return True if items_ contains an object whose getType() equals the given parameter
          */
         bool contains(const std::string& type) const;
 
+        /**
+         * @param typeId An integer denoting the type ID of the item to search for
+         * @return True if items_ contains an object whose getTypeId() equals the given parameter
+         */
+        bool contains(int typeId) const;
+
+        /**
+         * @brief Removes every item, keeping the box's storage so it can be refilled without allocating.
+         *      Lazy deletion stays as it was set. Every handle handed out before is invalidated, 
+         *      including ones restore() could otherwise have put back.
+         * @post size() == 0. If the storage was shared with a copy, the box first takes its own (see the copy constructor).
+         */
+        void reset();
+
+        /**
+         * @brief Turns lazy deletion on or off.
+         *      With lazy deletion, remove() marks the removed item's cells as free in O(1) instead of shifting
+         *      everything after it, coalescing them with the free runs on either side. addItem() reuses those runs first-fit.
+         *      The box is compacted when the free cells below the last item exceed `threshold` of the capacity, 
+         *      when addItem() finds no run long enough and no room at the end but the box has enough free cells in total,
+         *      or when defragment() is called. size() and count() are unaffected.
+         * 
+         * @param enabled True to turn lazy deletion on. Turning it off compacts the box right away.
+         * @param threshold The fraction of the capacity, in (0, 1], that may be left free before compacting. 
+         *      Values outside that range use the default of 0.25.
+         */
+        void setLazyDeletion(bool enabled, double threshold = 0.25);
+
+        /**
+         * @return True if lazy deletion is turned on
+         */
+        bool isLazyDeletion() const;
+
+        /**
+         * @brief Compacts the box in one linear pass, sliding every item left over the free runs lazy deletion left behind, 
+         *      so all the free cells are at the end again. Does nothing if there are no free runs.
+         * @post Handles stay valid, but cell indices (eg. from find()) taken before may not
+         */
+        void defragment();
+
+        /**
+         * @brief Finds the leftmost item of the given type from the given index to the end of the box
+         * @param typeId An integer denoting the type ID of the item to search for
+         * @param start The index of the first cell of an item to start searching from. Default 0.
+         * @return The index of the item within items_, or -1 if there is none
+         * @example Visiting every rook: 
+         *      for (int i = box.find(ROOK); i != -1; i = box.find(ROOK, i + box.at(i).size())) { ... }
+         */
+        int find(int typeId, int start = 0) const;
+
+        /**
+         * @brief Accesses the item whose first cell is at the given index (eg. one returned by find())
+         * @param index An index in [0, size_). It is not bounds checked.
+         * @return A reference to the item
+         * @note Changing the type or size of an item through this reference is not supported, 
+         *      since the box keeps per-type counts.
+         *      The non-const overload first gives the box its own copy of items_ if it is shared with a copy of the box.
+         */
+        const T& at(int index) const;
+        T& at(int index);
+
+        /**
+         * @brief Calls the given function once for every item in the box, from left to right.
+         *      Multi-cell items are visited once, and cells freed by lazy deletion are skipped.
+         *      For an ArrayBox<PieceCell>, pass a visitor through PieceCell::visit to reach each exact piece type
+         *      without virtual calls.
+         * @param function A callable taking a const reference to an item
+         */
+        template <typename Function>
+        void forEach(Function&& function) const;
+
+        /**
+         * @return An iterator to the leftmost item, so a box can be walked with a range-based for loop
+         */
+        const_iterator begin() const;
+
+        /**
+         * @return An iterator one past the last item
+         */
+        const_iterator end() const;
+
         /**
         * Getter for the size member
         * @return Returns the integer value stored in size_
@@ -137,7 +653,8 @@ class ArrayBox {
 
         /**
         * Getter for the capacity member
-        * @return Returns the integer value stored in capacity_
+        * @return Returns the integer value stored in capacity_, which is the constant N for a box with a fixed capacity,
+        *      so checks against it are resolved at compile time
         */
         int capacity() const;
 };
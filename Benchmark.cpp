@@ -0,0 +1,302 @@
+// File: Benchmark.cpp
+// Author: Tahfizur Rahman
+// Date: 10/16/2026
+// A source files that times ArrayBox, ChessBox, Pawn and Rook operations (built and run by `make bench`)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "ChessBox.hpp"
+#include "Pawn.hpp"
+#include "Rook.hpp"
+
+/**
+ * Output is one tab-separated line per benchmark, after a '#' line naming the build and a header line:
+ *
+ *      name    ns_per_op    allocs_per_op    ops_per_sec
+ *
+ * Benchmarks always run in the same order under the same names, so two runs can be diffed (or joined on name).
+ * ns_per_op is the median of several timed runs, each long enough to make the clock's resolution negligible.
+ * allocs_per_op counts every call to operator new made while timing, divided by the operations timed.
+ *
+ * usage: benchmark [--filter <substring>] [--min-time <seconds>] [--repetitions <n>]
+ */
+
+static std::atomic<uint64_t> allocations{0};   // The calls to any operator new so far
+
+void* operator new(std::size_t bytes) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(bytes > 0 ? bytes : 1)) { return block; }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t bytes, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* block = std::aligned_alloc(align, (std::max<std::size_t>(bytes, 1) + align - 1) / align * align)) { return block; }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t bytes) { return operator new(bytes); }
+void* operator new[](std::size_t bytes, std::align_val_t alignment) { return operator new(bytes, alignment); }
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t) noexcept { std::free(block); }
+void operator delete(void* block, std::align_val_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept { std::free(block); }
+
+/**
+ * @brief Keeps the compiler from optimizing away a value the benchmark computes but never uses
+ */
+template <typename T>
+static void keep(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+struct Options {
+    std::string filter;         // Only benchmarks whose name contains this run
+    double minTime = 0.1;       // The seconds each timed run lasts at least
+    int repetitions = 5;        // The timed runs whose median is reported
+};
+
+static Options options;
+
+/**
+ * @brief Times body(iterations), which must perform that many operations, and prints one line of results.
+ *      The iterations are doubled until a run takes a hundredth of the minimum time, then scaled to the minimum time.
+ * @param name The name to report, which should stay the same from build to build
+ * @param body Called with the number of operations to perform
+ */
+template <typename Body>
+static void run(const std::string& name, Body&& body) {
+    if (name.find(options.filter) == std::string::npos) { return; }
+
+    using Clock = std::chrono::steady_clock;
+    auto time = [&body](uint64_t iterations) {
+        auto start = Clock::now();
+        body(iterations);
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    uint64_t iterations = 1;
+    double seconds = time(iterations);
+    while (seconds < options.minTime / 100 && iterations < (uint64_t{1} << 40)) {
+        iterations *= 2;
+        seconds = time(iterations);
+    }
+    iterations = std::max<uint64_t>(1, static_cast<uint64_t>(iterations * options.minTime / std::max(seconds, 1e-9)));
+
+    std::vector<double> nanoseconds;
+    uint64_t allocated = 0;
+    for (int i = 0; i < options.repetitions; i++) {
+        uint64_t before = allocations.load(std::memory_order_relaxed);
+        nanoseconds.push_back(time(iterations) * 1e9 / iterations);
+        allocated += allocations.load(std::memory_order_relaxed) - before;
+    }
+    std::sort(nanoseconds.begin(), nanoseconds.end());
+    double median = nanoseconds[nanoseconds.size() / 2];
+
+    std::printf("%s\t%.2f\t%.2f\t%.0f\n", name.c_str(), median,
+        static_cast<double>(allocated) / (static_cast<double>(iterations) * options.repetitions), median > 0 ? 1e9 / median : 0.0);
+    std::fflush(stdout);
+}
+
+/**
+ * @brief The pieces a box is filled with, which decide how many cells each item takes
+ */
+struct Mix {
+    const char* name;
+    std::vector<PieceCell> pieces;   // Added in turn, over and over
+};
+
+static std::vector<Mix> mixes() {
+    ChessPiece queen("BLACK", -1, -1, false, 3, "QUEEN");
+    return {
+        {"pawn", {Pawn("BLACK")}},
+        {"mixed", {Pawn("BLACK"), Rook("BLACK"), queen}},
+        {"queen", {queen}},
+    };
+}
+
+/**
+ * @brief Fills a box with the mix's pieces in turn until the next one would take it past percent of its capacity
+ * @return The number of pieces added
+ */
+static int fill(PieceBox& box, const Mix& mix, int percent) {
+    int target = box.capacity() * percent / 100;
+    int added = 0;
+    while (true) {
+        const PieceCell& piece = mix.pieces[added % mix.pieces.size()];
+        if (box.size() + piece.size() > target || !box.addItem(piece)) { return added; }
+        added++;
+    }
+}
+
+/**
+ * @brief ArrayBox operations, at several fill levels and mixes of piece sizes.
+ *      Adds and removes are timed in pairs, so the box stays at the same fill level however many operations are run.
+ */
+static void benchArrayBox() {
+    for (const Mix& mix : mixes()) {
+        for (int percent : {25, 50, 90}) {
+            std::string suffix = std::string("/") + mix.name + "/fill" + std::to_string(percent);
+            const PieceCell& extra = mix.pieces.back();
+
+            // Every benchmark starts from its own freshly filled box, so earlier ones can not change what it measures
+            auto filled = [&mix, percent]() {
+                PieceBox box(64);
+                fill(box, mix, percent);
+                return box;
+            };
+
+            // The new item goes at the end, or the first free run, and is taken straight back out by its handle
+            run("arraybox.add_remove_handle" + suffix, [&](uint64_t iterations) {
+                PieceBox box = filled();
+                for (uint64_t i = 0; i < iterations; i++) {
+                    BoxHandle handle = box.addItem(extra);
+                    box.remove(handle);
+                }
+            });
+
+            // Removing the first item by type shifts every item after it, then it is added back at the end
+            run("arraybox.remove_type_add" + suffix, [&](uint64_t iterations) {
+                PieceBox box = filled();
+                const PieceCell first = box.at(0);
+                for (uint64_t i = 0; i < iterations; i++) {
+                    box.remove(first.getTypeId());
+                    box.addItem(first);
+                }
+            });
+
+            run("arraybox.count_name" + suffix, [&](uint64_t iterations) {
+                PieceBox box = filled();
+                int total = 0;
+                for (uint64_t i = 0; i < iterations; i++) { total += box.count("ROOK"); }
+                keep(total);
+            });
+
+            run("arraybox.contains_name" + suffix, [&](uint64_t iterations) {
+                PieceBox box = filled();
+                int total = 0;
+                for (uint64_t i = 0; i < iterations; i++) { total += box.contains("QUEEN"); }
+                keep(total);
+            });
+        }
+    }
+}
+
+/**
+ * @brief ChessBox construction, with colors that are kept as given and colors that have to be normalized,
+ *      and copies of a player's pieces
+ */
+static void benchChessBox() {
+    run("chessbox.construct/default", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            ChessBox box;
+            keep(box);
+        }
+    });
+
+    run("chessbox.construct/uppercase", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            ChessBox box("RED", "GREEN", 64);
+            keep(box);
+        }
+    });
+
+    run("chessbox.construct/normalized", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            ChessBox box("red", "green", 64);
+            keep(box);
+        }
+    });
+
+    run("chessbox.resolve_colors", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            std::pair<std::string, std::string> colors = ChessBox::resolveColors("Crimson", "NAVY");
+            keep(colors);
+        }
+    });
+
+    ChessBox box;
+    for (int col = 0; col < 8; col++) {
+        box.addPiece(Pawn("BLACK", 1, col, true, true));
+        box.addPiece(Rook("BLACK", 0, col, true));
+    }
+
+    run("chessbox.get_p1_pieces", [&box](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            PieceBox pieces = box.getP1Pieces();
+            keep(pieces);
+        }
+    });
+
+    // Changing the copy makes it take its own storage
+    run("chessbox.get_p1_pieces_write", [&box](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            PieceBox pieces = box.getP1Pieces();
+            pieces.remove(PieceType::PAWN);
+            keep(pieces);
+        }
+    });
+}
+
+/**
+ * @brief Pawn and Rook construction
+ */
+static void benchPieces() {
+    run("pawn.construct", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            Pawn pawn("BLACK", 1, 1, false, true);
+            keep(pawn);
+        }
+    });
+
+    run("rook.construct", [](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            Rook rook("WHITE", 7, 7, true, 3);
+            keep(rook);
+        }
+    });
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.minTime = std::atof(argv[++i]);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            options.repetitions = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter <substring>] [--min-time <seconds>] [--repetitions <n>]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (options.minTime <= 0 || options.repetitions <= 0) {
+        std::fprintf(stderr, "--min-time and --repetitions must be positive\n");
+        return 1;
+    }
+
+#ifdef CHESSBOX_INLINE_CAPACITY
+    std::printf("# benchmark version=1 inline_capacity=%d stats=%d\n", CHESSBOX_INLINE_CAPACITY, BoxStats::ENABLED ? 1 : 0);
+#else
+    std::printf("# benchmark version=1 inline_capacity=0 stats=%d\n", BoxStats::ENABLED ? 1 : 0);
+#endif
+    std::printf("name\tns_per_op\tallocs_per_op\tops_per_sec\n");
+
+    benchArrayBox();
+    benchChessBox();
+    benchPieces();
+    return 0;
+}
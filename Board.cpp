@@ -0,0 +1,284 @@
+// File: Board.cpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A source files that defines Board
+
+#include "Board.hpp"
+#include <array>
+#include "Zobrist.hpp"
+
+/**
+ * @brief Tables the Zobrist keys every place / lift / move needs, for the type IDs that have their own bitboard
+ */
+static constexpr std::array<uint64_t, Board::PLAYERS * Board::MAX_TYPES * Board::SQUARES> buildPieceKeys() {
+    std::array<uint64_t, Board::PLAYERS * Board::MAX_TYPES * Board::SQUARES> keys{};
+    for (int player = 0; player < Board::PLAYERS; player++) {
+        for (int typeId = 0; typeId < Board::MAX_TYPES; typeId++) {
+            for (int square = 0; square < Board::SQUARES; square++) {
+                keys[(player * Board::MAX_TYPES + typeId) * Board::SQUARES + square] = Zobrist::piece(player, typeId, square);
+            }
+        }
+    }
+    return keys;
+}
+
+static constexpr std::array<uint64_t, Board::SQUARES> buildFlagKeys(uint64_t (*key)(int)) {
+    std::array<uint64_t, Board::SQUARES> keys{};
+    for (int square = 0; square < Board::SQUARES; square++) { keys[square] = key(square); }
+    return keys;
+}
+
+static constexpr std::array<uint64_t, Board::PLAYERS * Board::MAX_TYPES * Board::SQUARES> PIECE_KEYS = buildPieceKeys();
+static constexpr std::array<uint64_t, Board::SQUARES> MOVING_UP_KEYS = buildFlagKeys(Zobrist::movingUp);
+static constexpr std::array<uint64_t, Board::SQUARES> DOUBLE_JUMP_KEYS = buildFlagKeys(Zobrist::doubleJump);
+
+/**
+ * @brief Default constructor. An empty board where P1 is "BLACK" and P2 is "WHITE"
+ */
+Board::Board() : Board(NameRegistry::colors().find("BLACK"), NameRegistry::colors().find("WHITE")) {}
+
+/**
+ * @brief Parameterized constructor. An empty board for the given player colors
+ * @param p1ColorId The NameRegistry::colors() ID of P1's color
+ * @param p2ColorId The NameRegistry::colors() ID of P2's color
+ */
+Board::Board(int p1ColorId, int p2ColorId) : colorIds_{p1ColorId, p2ColorId} {
+    clear();
+}
+
+/**
+ * @return True if (row, col) lies within the board's dimensions
+ */
+bool Board::onBoard(int row, int col) {
+    return row >= 0 && row < ChessPiece::BOARD_LENGTH && col >= 0 && col < ChessPiece::BOARD_LENGTH;
+}
+
+/**
+ * @return The Zobrist key of everything the board knows about the piece on the given occupied square
+ */
+uint64_t Board::keyAt(int player, int square) const {
+    int typeId = typeAt_[square];
+    Bitboard bit = Bitboard{1} << square;
+    uint64_t key = typeId < MAX_TYPES ? PIECE_KEYS[(player * MAX_TYPES + typeId) * SQUARES + square] : Zobrist::piece(player, typeId, square);
+    if (movingUp_ & bit) { key ^= MOVING_UP_KEYS[square]; }
+    if (doubleJumpable_ & bit) { key ^= DOUBLE_JUMP_KEYS[square]; }
+    return key ^ Zobrist::castleMoves(square, castleMovesAt_[square]);
+}
+
+/**
+ * @brief Marks a square as occupied by a piece of the given player and type
+ * @param player The index of the player (0 for P1, 1 for P2)
+ * @param typeId The type ID of the piece
+ * @param row, col The square the piece stands on, both in [0, BOARD_LENGTH)
+ * @param movingUp Whether the piece is moving up the board. Default false.
+ * @param doubleJumpable Whether the piece (a Pawn) can double jump. Default false.
+ * @param castleMoves The castle moves the piece (a Rook) has left. Default 0.
+ * @return True if the piece was placed. False if the square is off the board or already occupied,
+ *      or typeId is outside [0, MAX_TYPE_ID].
+ */
+bool Board::place(int player, int typeId, int row, int col, bool movingUp, bool doubleJumpable, int castleMoves) {
+    if (!onBoard(row, col) || isOccupied(row, col) || typeId < 0 || typeId > MAX_TYPE_ID) { return false; }
+
+    Bitboard bit = squareBit(row, col);
+    byPlayer_[player] |= bit;
+    if (movingUp) { movingUp_ |= bit; }
+    if (doubleJumpable) { doubleJumpable_ |= bit; }
+    if (typeId < MAX_TYPES) { byType_[typeId] |= bit; }
+    typeAt_[square(row, col)] = static_cast<unsigned char>(typeId);
+    castleMovesAt_[square(row, col)] = castleMoves;
+    hash_ ^= keyAt(player, square(row, col));
+    return true;
+}
+
+/**
+ * @brief Clears a square that was occupied by a piece of the given player
+ * @param player The index of the player (0 for P1, 1 for P2)
+ * @param row, col The square to clear
+ * @return True if the square was occupied by that player and is now empty. False otherwise.
+ */
+bool Board::lift(int player, int row, int col) {
+    if (!onBoard(row, col)) { return false; }
+
+    Bitboard bit = squareBit(row, col);
+    if ((byPlayer_[player] & bit) == 0) { return false; }
+
+    int typeId = typeAt_[square(row, col)];
+    hash_ ^= keyAt(player, square(row, col));
+    castleMovesAt_[square(row, col)] = 0;
+    byPlayer_[player] &= ~bit;
+    movingUp_ &= ~bit;
+    doubleJumpable_ &= ~bit;
+    if (typeId < MAX_TYPES) { byType_[typeId] &= ~bit; }
+    return true;
+}
+
+/**
+ * @brief Moves a piece of the given player from one square to an empty square. 
+ *        The piece keeps its movingUp and double jump flags, and its castle moves.
+ * @return True if the piece was moved. False if there was no such piece or the destination is occupied.
+ */
+bool Board::move(int player, int fromRow, int fromCol, int toRow, int toCol) {
+    if (!onBoard(fromRow, fromCol) || !onBoard(toRow, toCol)) { return false; }
+    if ((byPlayer_[player] & squareBit(fromRow, fromCol)) == 0 || isOccupied(toRow, toCol)) { return false; }
+
+    int from = square(fromRow, fromCol), to = square(toRow, toCol);
+    int typeId = typeAt_[from];
+    hash_ ^= keyAt(player, from);
+    Bitboard fromTo = squareBit(fromRow, fromCol) | squareBit(toRow, toCol);
+    byPlayer_[player] ^= fromTo;
+    if (typeId < MAX_TYPES) { byType_[typeId] ^= fromTo; }
+    if (movingUp_ & fromTo) { movingUp_ ^= fromTo; }
+    if (doubleJumpable_ & fromTo) { doubleJumpable_ ^= fromTo; }
+    typeAt_[to] = static_cast<unsigned char>(typeId);
+    castleMovesAt_[to] = castleMovesAt_[from];
+    castleMovesAt_[from] = 0;
+    hash_ ^= keyAt(player, to);
+    return true;
+}
+
+/**
+ * @brief Sets whether the piece on (row, col) can double jump. Empty squares are left alone.
+ */
+void Board::setDoubleJump(int row, int col, bool flag) {
+    if (!isOccupied(row, col)) { return; }
+
+    Bitboard bit = squareBit(row, col);
+    if (((doubleJumpable_ & bit) != 0) == flag) { return; }
+    doubleJumpable_ ^= bit;
+    hash_ ^= DOUBLE_JUMP_KEYS[square(row, col)];
+}
+
+/**
+ * @brief Sets the castle moves the piece on (row, col) has left. Empty squares are left alone.
+ */
+void Board::setCastleMoves(int row, int col, int castleMoves) {
+    if (!isOccupied(row, col)) { return; }
+
+    int s = square(row, col);
+    hash_ ^= Zobrist::castleMoves(s, castleMovesAt_[s]) ^ Zobrist::castleMoves(s, castleMoves);
+    castleMovesAt_[s] = castleMoves;
+}
+
+/**
+ * @brief Empties the board. The player colors are kept.
+ */
+void Board::clear() {
+    for (int p = 0; p < PLAYERS; p++) { byPlayer_[p] = 0; }
+    movingUp_ = 0;
+    doubleJumpable_ = 0;
+    for (int t = 0; t < MAX_TYPES; t++) { byType_[t] = 0; }
+    for (int s = 0; s < SQUARES; s++) { 
+        typeAt_[s] = PieceType::NONE; 
+        castleMovesAt_[s] = 0;
+    }
+    hash_ = 0;
+}
+
+/**
+ * @return The squares occupied by either player
+ */
+Bitboard Board::occupied() const {
+    return byPlayer_[0] | byPlayer_[1];
+}
+
+/**
+ * @param player The index of the player (0 for P1, 1 for P2)
+ * @return The squares occupied by that player
+ */
+Bitboard Board::occupiedBy(int player) const {
+    return byPlayer_[player];
+}
+
+/**
+ * @param typeId A type ID
+ * @return The squares occupied by pieces of that type, for both players
+ */
+Bitboard Board::pieces(int typeId) const {
+    if (typeId < 0 || typeId >= MAX_TYPES) { return 0; }
+    return byType_[typeId];
+}
+
+/**
+ * @param player The index of the player (0 for P1, 1 for P2)
+ * @param typeId A type ID
+ * @return The squares occupied by that player's pieces of that type
+ */
+Bitboard Board::pieces(int player, int typeId) const {
+    return pieces(typeId) & byPlayer_[player];
+}
+
+/**
+ * @return The occupied squares whose piece is moving up the board
+ */
+Bitboard Board::movingUp() const {
+    return movingUp_;
+}
+
+/**
+ * @return The occupied squares whose piece can still double jump
+ */
+Bitboard Board::doubleJumpable() const {
+    return doubleJumpable_;
+}
+
+/**
+ * @return The castle moves the piece on (row, col) has left, or 0 if it is empty or off the board
+ */
+int Board::castleMovesAt(int row, int col) const {
+    if (!isOccupied(row, col)) { return 0; }
+    return castleMovesAt_[square(row, col)];
+}
+
+/**
+ * @brief The Zobrist hash of the position (see Zobrist), updated in O(1) by every change to the board.
+ *      Two boards with the same pieces on the same squares, with the same flags and castle moves, hash the same.
+ * @return The 64-bit hash. 0 for an empty board.
+ */
+uint64_t Board::hash() const {
+    return hash_;
+}
+
+/**
+ * @return True if the square (row, col) is occupied. Squares off the board are never occupied.
+ */
+bool Board::isOccupied(int row, int col) const {
+    return onBoard(row, col) && (occupied() & squareBit(row, col)) != 0;
+}
+
+/**
+ * @return The index of the player on (row, col), or -1 if it is empty or off the board
+ */
+int Board::playerAt(int row, int col) const {
+    if (!onBoard(row, col)) { return -1; }
+
+    Bitboard bit = squareBit(row, col);
+    if (byPlayer_[0] & bit) { return 0; }
+    if (byPlayer_[1] & bit) { return 1; }
+    return -1;
+}
+
+/**
+ * @return The type ID of the piece on (row, col), or PieceType::NONE if it is empty or off the board
+ */
+int Board::typeAt(int row, int col) const {
+    if (!isOccupied(row, col)) { return PieceType::NONE; }
+    return typeAt_[square(row, col)];
+}
+
+/**
+ * @param colorId A NameRegistry::colors() ID
+ * @return The index of the player with that color, or -1 if neither player has it
+ */
+int Board::playerOf(int colorId) const {
+    if (colorId == colorIds_[0]) { return 0; }
+    if (colorId == colorIds_[1]) { return 1; }
+    return -1;
+}
+
+/**
+ * @param player The index of the player (0 for P1, 1 for P2)
+ * @return The NameRegistry::colors() ID of that player's color
+ */
+int Board::colorIdOf(int player) const {
+    return colorIds_[player];
+}
@@ -0,0 +1,193 @@
+// File: Board.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines Board, a bitboard view of which pieces stand on which squares
+
+#pragma once
+#include <cstdint>
+#include "ChessPiece.hpp"
+
+/**
+ * A 64-bit set of squares. Square (row, col) is bit row * BOARD_LENGTH + col, 
+ * so bit 0 is (0, 0) and bit 63 is (7, 7) in the grid drawn in ChessPiece.hpp.
+ */
+using Bitboard = uint64_t;
+
+/**
+ * @class Board
+ * @brief Tracks the squares occupied by each player and by each piece type as 64-bit bitboards.
+ * 
+ * A Board does not own any pieces, it only mirrors where the pieces of a ChessBox stand. 
+ * It is updated incrementally through place(), lift() and move(), 
+ * so "what is on (r, c)" and "which squares are occupied" are answered with single bit operations.
+ */
+class Board {
+    public:
+        static const int PLAYERS = 2;     // P1 is player 0, P2 is player 1
+        static const int MAX_TYPES = 16;  // Types with an ID >= MAX_TYPES only show up in the per-player occupancy
+        static const int MAX_TYPE_ID = 0xFF;   // The largest type ID a square can hold (typeAt_ is one byte per square)
+        static const int SQUARES = ChessPiece::BOARD_LENGTH * ChessPiece::BOARD_LENGTH;
+
+    private:
+        Bitboard byPlayer_[PLAYERS];        // byPlayer_[p] holds every square occupied by player p
+        Bitboard byType_[MAX_TYPES];        // byType_[t] holds every square occupied by a piece of type ID t, for both players
+        Bitboard movingUp_;                 // The occupied squares whose piece is moving up the board
+        Bitboard doubleJumpable_;           // The occupied squares whose piece (a Pawn) can still double jump
+        unsigned char typeAt_[SQUARES];     // The type ID on each occupied square (meaningless on empty squares)
+        int castleMovesAt_[SQUARES];        // The castle moves left for the piece (a Rook) on each square, 0 on empty squares
+        int colorIds_[PLAYERS];             // The NameRegistry::colors() ID of each player
+        uint64_t hash_;                     // The Zobrist hash of everything above except the colors, kept up to date incrementally
+
+        /**
+         * @return The Zobrist key of everything the board knows about the piece on the given occupied square
+         */
+        uint64_t keyAt(int player, int square) const;
+
+    public:
+        /**
+         * @brief Default constructor. An empty board where P1 is "BLACK" and P2 is "WHITE"
+         */
+        Board();
+
+        /**
+         * @brief Parameterized constructor. An empty board for the given player colors
+         * @param p1ColorId The NameRegistry::colors() ID of P1's color
+         * @param p2ColorId The NameRegistry::colors() ID of P2's color
+         */
+        Board(int p1ColorId, int p2ColorId);
+
+        /**
+         * @return True if (row, col) lies within the board's dimensions
+         */
+        static bool onBoard(int row, int col);
+
+        /**
+         * @param row A row in [0, BOARD_LENGTH)
+         * @param col A column in [0, BOARD_LENGTH)
+         * @return The bit index of the square (row, col)
+         */
+        static int square(int row, int col) { return row * ChessPiece::BOARD_LENGTH + col; }
+
+        /**
+         * @param row A row in [0, BOARD_LENGTH)
+         * @param col A column in [0, BOARD_LENGTH)
+         * @return A bitboard with only the square (row, col) set
+         */
+        static Bitboard squareBit(int row, int col) { return Bitboard{1} << square(row, col); }
+
+        /**
+         * @brief Marks a square as occupied by a piece of the given player and type
+         * @param player The index of the player (0 for P1, 1 for P2)
+         * @param typeId The type ID of the piece
+         * @param row, col The square the piece stands on, both in [0, BOARD_LENGTH)
+         * @param movingUp Whether the piece is moving up the board. Default false.
+         * @param doubleJumpable Whether the piece (a Pawn) can double jump. Default false.
+         * @param castleMoves The castle moves the piece (a Rook) has left. Default 0.
+         * @return True if the piece was placed. False if the square is off the board or already occupied,
+         *      or typeId is outside [0, MAX_TYPE_ID].
+         */
+        bool place(int player, int typeId, int row, int col, bool movingUp = false, bool doubleJumpable = false, int castleMoves = 0);
+
+        /**
+         * @brief Clears a square that was occupied by a piece of the given player
+         * @param player The index of the player (0 for P1, 1 for P2)
+         * @param row, col The square to clear
+         * @return True if the square was occupied by that player and is now empty. False otherwise.
+         */
+        bool lift(int player, int row, int col);
+
+        /**
+         * @brief Moves a piece of the given player from one square to an empty square. 
+         *        The piece keeps its movingUp and double jump flags, and its castle moves.
+         * @return True if the piece was moved. False if there was no such piece or the destination is occupied.
+         */
+        bool move(int player, int fromRow, int fromCol, int toRow, int toCol);
+
+        /**
+         * @brief Sets whether the piece on (row, col) can double jump. Empty squares are left alone.
+         */
+        void setDoubleJump(int row, int col, bool flag);
+
+        /**
+         * @brief Sets the castle moves the piece on (row, col) has left. Empty squares are left alone.
+         */
+        void setCastleMoves(int row, int col, int castleMoves);
+
+        /**
+         * @brief Empties the board. The player colors are kept.
+         */
+        void clear();
+
+        /**
+         * @return The squares occupied by either player
+         */
+        Bitboard occupied() const;
+
+        /**
+         * @param player The index of the player (0 for P1, 1 for P2)
+         * @return The squares occupied by that player
+         */
+        Bitboard occupiedBy(int player) const;
+
+        /**
+         * @param typeId A type ID
+         * @return The squares occupied by pieces of that type, for both players
+         */
+        Bitboard pieces(int typeId) const;
+
+        /**
+         * @param player The index of the player (0 for P1, 1 for P2)
+         * @param typeId A type ID
+         * @return The squares occupied by that player's pieces of that type
+         */
+        Bitboard pieces(int player, int typeId) const;
+
+        /**
+         * @return The occupied squares whose piece is moving up the board
+         */
+        Bitboard movingUp() const;
+
+        /**
+         * @return The occupied squares whose piece can still double jump
+         */
+        Bitboard doubleJumpable() const;
+
+        /**
+         * @return The castle moves the piece on (row, col) has left, or 0 if it is empty or off the board
+         */
+        int castleMovesAt(int row, int col) const;
+
+        /**
+         * @brief The Zobrist hash of the position (see Zobrist), updated in O(1) by every change to the board.
+         *      Two boards with the same pieces on the same squares, with the same flags and castle moves, hash the same.
+         * @return The 64-bit hash. 0 for an empty board.
+         */
+        uint64_t hash() const;
+
+        /**
+         * @return True if the square (row, col) is occupied. Squares off the board are never occupied.
+         */
+        bool isOccupied(int row, int col) const;
+
+        /**
+         * @return The index of the player on (row, col), or -1 if it is empty or off the board
+         */
+        int playerAt(int row, int col) const;
+
+        /**
+         * @return The type ID of the piece on (row, col), or PieceType::NONE if it is empty or off the board
+         */
+        int typeAt(int row, int col) const;
+
+        /**
+         * @param colorId A NameRegistry::colors() ID
+         * @return The index of the player with that color, or -1 if neither player has it
+         */
+        int playerOf(int colorId) const;
+
+        /**
+         * @param player The index of the player (0 for P1, 1 for P2)
+         * @return The NameRegistry::colors() ID of that player's color
+         */
+        int colorIdOf(int player) const;
+};
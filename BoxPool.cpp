@@ -0,0 +1,96 @@
+// File: BoxPool.cpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A source files that defines BoxPool
+
+#include "BoxPool.hpp"
+#include <new>
+
+/**
+ * @brief Destructor
+ * @post Frees every slab. Any block still handed out is freed with it.
+ */
+BoxPool::~BoxPool() {
+    for (void* slab : slabs_) {
+        ::operator delete(slab, std::align_val_t(ALIGNMENT));
+    }
+}
+
+/**
+ * @return The given size rounded up to a whole, non-zero number of ALIGNMENT bytes
+ */
+size_t BoxPool::roundUp(size_t bytes) {
+    return bytes == 0 ? ALIGNMENT : (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+/**
+ * @return The class of blocks of exactly the given (already rounded) size, created if there is none yet
+ */
+BoxPool::SizeClass& BoxPool::classOf(size_t bytes) {
+    for (SizeClass& sizeClass : classes_) {
+        if (sizeClass.bytes == bytes) { return sizeClass; }
+    }
+    classes_.push_back(SizeClass{bytes});
+    return classes_.back();
+}
+
+/**
+ * @brief Hands out a block of at least the given size, aligned to ALIGNMENT
+ * @param bytes The size of the block
+ * @return A pointer to the block. Its contents are unspecified.
+ */
+void* BoxPool::acquire(size_t bytes) {
+    bytes = roundUp(bytes);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    SizeClass& sizeClass = classOf(bytes);
+    if (sizeClass.free == nullptr) {
+        // Carve a new slab into blocks and thread them all onto the free list
+        char* slab = static_cast<char*>(::operator new(bytes * BLOCKS_PER_SLAB, std::align_val_t(ALIGNMENT)));
+        slabs_.push_back(slab);
+        reserved_ += bytes * BLOCKS_PER_SLAB;
+        for (int i = BLOCKS_PER_SLAB - 1; i >= 0; i--) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * bytes);
+            block->next = sizeClass.free;
+            sizeClass.free = block;
+        }
+    }
+
+    FreeBlock* block = sizeClass.free;
+    sizeClass.free = block->next;
+    inUse_++;
+    return block;
+}
+
+/**
+ * @brief Takes back a block handed out by acquire(), for a later acquire() of the same size to reuse
+ * @param block The block
+ * @param bytes The size it was acquired with
+ */
+void BoxPool::recycle(void* block, size_t bytes) {
+    if (block == nullptr) { return; }
+    bytes = roundUp(bytes);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    SizeClass& sizeClass = classOf(bytes);
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = sizeClass.free;
+    sizeClass.free = freed;
+    inUse_--;
+}
+
+/**
+ * @return The blocks handed out and not yet recycled
+ */
+size_t BoxPool::blocksInUse() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inUse_;
+}
+
+/**
+ * @return The total bytes the pool has allocated from the system
+ */
+size_t BoxPool::bytesReserved() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reserved_;
+}
@@ -0,0 +1,90 @@
+// File: BoxPool.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines BoxPool, a slab allocator for the storage of ArrayBoxes (and so ChessBoxes)
+
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class BoxPool
+ * @brief Hands out fixed-size blocks carved from large slabs, and takes them back onto a free list instead of freeing them.
+ * 
+ * An ArrayBox keeps all of its arrays in one block, whose size only depends on its item type and capacity, 
+ * so a program creating and destroying many boxes of the same kind (eg. a million ChessBoxes) keeps asking for 
+ * the same one or two block sizes. The pool keeps one free list per block size: acquire() pops a block off it, 
+ * recycle() pushes the block back, and only when the list is empty does the pool allocate a new slab of 
+ * BLOCKS_PER_SLAB blocks at once. Memory goes back to the system only when the pool is destroyed.
+ * 
+ * Blocks are rounded up to whole cache lines and start on one, so two boxes never share a line.
+ * The pool is thread-safe (copies of a box may be unshared or released on other threads), 
+ * and must outlive every box that allocates from it.
+ */
+class BoxPool {
+    public:
+        static const int BLOCKS_PER_SLAB = 64;   // The number of blocks allocated at once when a free list runs dry
+        static const size_t ALIGNMENT = 64;      // The alignment and size granularity of every block
+
+    private:
+        struct FreeBlock {
+            FreeBlock* next;   // The next free block of the same size. Stored inside the free block itself.
+        };
+
+        struct SizeClass {
+            size_t bytes;                 // The size of every block in this class
+            FreeBlock* free = nullptr;    // The top of the free list
+        };
+
+        mutable std::mutex mutex_;        // Guards everything below
+        std::vector<SizeClass> classes_;  // One per block size seen so far. There are only ever a few, so they are searched linearly.
+        std::vector<void*> slabs_;        // Every slab allocated, freed by the destructor
+        size_t reserved_ = 0;             // The total bytes of every slab
+        size_t inUse_ = 0;                // The blocks handed out and not yet recycled
+
+        /**
+         * @return The given size rounded up to a whole, non-zero number of ALIGNMENT bytes
+         */
+        static size_t roundUp(size_t bytes);
+
+        /**
+         * @return The class of blocks of exactly the given (already rounded) size, created if there is none yet
+         */
+        SizeClass& classOf(size_t bytes);
+
+    public:
+        BoxPool() = default;
+        BoxPool(const BoxPool&) = delete;
+        BoxPool& operator=(const BoxPool&) = delete;
+
+        /**
+         * @brief Destructor
+         * @post Frees every slab. Any block still handed out is freed with it.
+         */
+        ~BoxPool();
+
+        /**
+         * @brief Hands out a block of at least the given size, aligned to ALIGNMENT
+         * @param bytes The size of the block
+         * @return A pointer to the block. Its contents are unspecified.
+         */
+        void* acquire(size_t bytes);
+
+        /**
+         * @brief Takes back a block handed out by acquire(), for a later acquire() of the same size to reuse
+         * @param block The block
+         * @param bytes The size it was acquired with
+         */
+        void recycle(void* block, size_t bytes);
+
+        /**
+         * @return The blocks handed out and not yet recycled
+         */
+        size_t blocksInUse() const;
+
+        /**
+         * @return The total bytes the pool has allocated from the system
+         */
+        size_t bytesReserved() const;
+};
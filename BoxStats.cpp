@@ -0,0 +1,45 @@
+// File: BoxStats.cpp
+// Author: Tahfizur Rahman
+// Date: 10/16/2026
+// A source files that defines BoxStats and, when built with CHESSBOX_STATS, the counters behind it
+
+#include "BoxStats.hpp"
+#include <initializer_list>
+
+#ifdef CHESSBOX_STATS
+namespace BoxCounters {
+    Counter searches, cellsProbed, removes, cellsShifted, defaultsWritten, failedAdds, pieceCopies, unshares;
+}
+#endif
+
+/**
+ * @return The counts so far, or all zeros when built without CHESSBOX_STATS
+ * @note Counts still being added to on other threads may be read part way through a call
+ */
+BoxStats BoxStats::read() {
+    BoxStats stats;
+#ifdef CHESSBOX_STATS
+    stats.searches = BoxCounters::searches.value.load(std::memory_order_relaxed);
+    stats.cellsProbed = BoxCounters::cellsProbed.value.load(std::memory_order_relaxed);
+    stats.removes = BoxCounters::removes.value.load(std::memory_order_relaxed);
+    stats.cellsShifted = BoxCounters::cellsShifted.value.load(std::memory_order_relaxed);
+    stats.defaultsWritten = BoxCounters::defaultsWritten.value.load(std::memory_order_relaxed);
+    stats.failedAdds = BoxCounters::failedAdds.value.load(std::memory_order_relaxed);
+    stats.pieceCopies = BoxCounters::pieceCopies.value.load(std::memory_order_relaxed);
+    stats.unshares = BoxCounters::unshares.value.load(std::memory_order_relaxed);
+#endif
+    return stats;
+}
+
+/**
+ * @brief Sets every count back to 0
+ */
+void BoxStats::reset() {
+#ifdef CHESSBOX_STATS
+    for (BoxCounters::Counter* counter : {&BoxCounters::searches, &BoxCounters::cellsProbed, &BoxCounters::removes,
+            &BoxCounters::cellsShifted, &BoxCounters::defaultsWritten, &BoxCounters::failedAdds,
+            &BoxCounters::pieceCopies, &BoxCounters::unshares}) {
+        counter->value.store(0, std::memory_order_relaxed);
+    }
+#endif
+}
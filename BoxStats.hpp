@@ -0,0 +1,57 @@
+// File: BoxStats.hpp
+// Author: Tahfizur Rahman
+// Date: 10/16/2026
+// A header files that defines BoxStats, counters of the work done on the hot paths of ArrayBox and ChessBox
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Build with -DCHESSBOX_STATS to count the work described in BoxStats. Without it, every BOX_STAT() compiles to
+// nothing (its arguments are not even evaluated) and BoxStats::read() always returns zeros.
+
+/**
+ * @struct BoxStats
+ * @brief A snapshot of the counters, summed over every ArrayBox and ChessBox in the process and every thread.
+ *      Divide a count by the number of calls it belongs to for a per-call figure, eg. cellsProbed / searches.
+ *      With CHESSBOX_STATS, each count is one relaxed atomic add per call, so boxes used from many threads at once
+ *      (eg. a parallel perft) contend on the counters' cache lines.
+ */
+struct BoxStats {
+#ifdef CHESSBOX_STATS
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    uint64_t searches = 0;          // ArrayBox::getIndexOf calls that scanned the box
+    uint64_t cellsProbed = 0;       // Cells those calls looked at
+    uint64_t removes = 0;           // Items removed from an ArrayBox
+    uint64_t cellsShifted = 0;      // Cells moved left to close the gap a removed item left (remove() and compacting)
+    uint64_t defaultsWritten = 0;   // Cells overwritten with a default-initialized item (a NONE ChessPiece in a ChessBox)
+    uint64_t failedAdds = 0;        // ArrayBox::addItem calls that failed because the item did not fit
+    uint64_t pieceCopies = 0;       // Boxes copied out by ChessBox::getP1Pieces / getP2Pieces
+    uint64_t unshares = 0;          // Shared (copy-on-write) storage copied because one of its boxes was written to
+
+    /**
+     * @return The counts so far, or all zeros when built without CHESSBOX_STATS
+     */
+    static BoxStats read();
+
+    /**
+     * @brief Sets every count back to 0
+     */
+    static void reset();
+};
+
+#ifdef CHESSBOX_STATS
+namespace BoxCounters {
+    // One cache line each, so counting one kind of work does not slow down counting another
+    struct alignas(64) Counter { std::atomic<uint64_t> value{0}; };
+    extern Counter searches, cellsProbed, removes, cellsShifted, defaultsWritten, failedAdds, pieceCopies, unshares;
+}
+
+#define BOX_STAT(counter, amount) BoxCounters::counter.value.fetch_add(static_cast<uint64_t>(amount), std::memory_order_relaxed)
+#else
+#define BOX_STAT(counter, amount) ((void)0)
+#endif
@@ -0,0 +1,503 @@
+// File: BoxTest.cpp
+// Author: Tahfizur Rahman
+// Date: 10/16/2026
+// A source files that checks ArrayBox and ChessBox against simple models with random operations (built and run by `make test`)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ChessBox.hpp"
+#include "MoveGenerator.hpp"
+#include "Pawn.hpp"
+#include "Rook.hpp"
+
+/**
+ * Every check runs a long random sequence of operations on real boxes, and after each operation compares every box
+ * with a model that only knows which items should be in it. The sequence depends only on the seed, which is printed,
+ * so a failure can be replayed with --seed.
+ *
+ * Output is one line per check, then "ok" or the first mismatch found. The exit code is 0 only if every check passed.
+ *
+ * usage: boxtest [--seed <n>] [--steps <n>]
+ */
+
+struct Options {
+    uint32_t seed = 12345;  // Seeds every random sequence
+    int steps = 20000;      // The operations each check runs
+};
+
+static const int INLINE_CAPACITY = 24;   // The capacity of the inline boxes checked
+
+static Options options;
+static std::mt19937 rng;
+static int failures = 0;
+
+/**
+ * @return A uniformly random integer in [low, high]
+ */
+static int random(int low, int high) {
+    return std::uniform_int_distribution<int>(low, high)(rng);
+}
+
+/**
+ * @brief Records a failure, printing where it happened. Only the first few are printed.
+ * @return condition, so a check can stop at its first failure
+ */
+static bool expect(bool condition, const char* what, int step) {
+    if (!condition) {
+        if (failures < 10) { std::printf("  FAILED at step %d: %s\n", step, what); }
+        failures++;
+    }
+    return condition;
+}
+
+/**
+ * @struct Kind
+ * @brief One kind of piece the checks add: its type ID and the size of its pieces
+ */
+struct Kind {
+    std::string name;
+    int typeId;
+    int size;
+};
+
+/**
+ * @return The kinds of piece the checks add: the built-in types, types with other sizes, and types above
+ *      ArrayBox's one-byte tags (which share OVERFLOW_TAG, and which a box with a fixed capacity refuses)
+ */
+static std::vector<Kind> kinds() {
+    NameRegistry& types = NameRegistry::pieceTypes();
+    std::vector<Kind> result;
+    auto add = [&types, &result](const std::string& name, int size) { result.push_back({name, types.intern(name), size}); };
+    add("PAWN", 1);
+    add("ROOK", 2);
+    add("QUEEN", 3);
+    add("CRATE", 1);
+    add("WALL", 4);
+    for (int i = 0; types.size() <= FixedTypeTable<INLINE_CAPACITY>::LIMIT + 1; i++) { types.intern("FILLER_" + std::to_string(i)); }
+    add("GIANT", 2);
+    add("DWARF", 1);
+    return result;
+}
+
+static const std::vector<Kind>& allKinds() {
+    static const std::vector<Kind> result = kinds();
+    return result;
+}
+
+/**
+ * @return A random piece. Its square is a serial number, so two pieces added one after the other always differ.
+ */
+static PieceCell randomPiece() {
+    static int serial = 0;
+    serial++;
+    int row = serial / ChessPiece::BOARD_LENGTH % ChessPiece::BOARD_LENGTH, col = serial % ChessPiece::BOARD_LENGTH;
+    const Kind& kind = allKinds()[random(0, allKinds().size() - 1)];
+    if (kind.typeId == PieceType::PAWN && random(0, 1)) { return Pawn("BLACK", row, col, true, random(0, 1)); }
+    if (kind.typeId == PieceType::ROOK && random(0, 1)) { return Rook("BLACK", row, col, false, random(0, 3)); }
+    return ChessPiece("BLACK", row, col, false, kind.size, kind.name);
+}
+
+/**
+ * @return True if both cells hold the same piece, as far as the checks can tell pieces apart
+ */
+static bool same(const PieceCell& a, const PieceCell& b) {
+    return a.getTypeId() == b.getTypeId() && a.size() == b.size() && a.piece().getRow() == b.piece().getRow()
+        && a.piece().getColumn() == b.piece().getColumn() && (a.get<Pawn>() != nullptr) == (b.get<Pawn>() != nullptr)
+        && (a.get<Rook>() != nullptr) == (b.get<Rook>() != nullptr);
+}
+
+/**
+ * @struct Subject
+ * @brief A box under test and the model of what it should hold
+ */
+template <typename Box>
+struct Subject {
+    Box box;
+    std::vector<std::pair<BoxHandle, PieceCell>> live;      // Every item in the box, with its handle
+    std::vector<std::pair<BoxHandle, PieceCell>> removed;   // Recently removed items, which restore() may put back
+    std::vector<int> generation;                            // generation[s] is what slot s's generation should be now
+    std::vector<bool> owned;                                // owned[s] is true while a live item has slot s
+
+    explicit Subject(Box&& from) : box(std::move(from)), generation(box.capacity(), 0), owned(box.capacity(), false) {}
+
+    int size() const {
+        int total = 0;
+        for (const auto& item : live) { total += item.second.size(); }
+        return total;
+    }
+
+    /**
+     * @return True if the box would take an item of this type at all (a fixed-capacity box only counts some types)
+     */
+    bool tracks(int typeId) const {
+        return std::is_same<Box, ArrayBox<PieceCell>>::value || typeId < FixedTypeTable<INLINE_CAPACITY>::LIMIT;
+    }
+
+    /**
+     * @return The handles of every item, in the order the box holds them
+     */
+    std::vector<BoxHandle> order() const {
+        std::vector<BoxHandle> handles;
+        for (auto it = box.begin(); it != box.end(); ++it) { handles.push_back(box.handleAt(it.index())); }
+        return handles;
+    }
+
+    void remember(const BoxHandle& handle, const PieceCell& cell) {
+        removed.push_back({handle, cell});
+        if (removed.size() > 8) { removed.erase(removed.begin()); }
+    }
+
+    /**
+     * @brief Updates the model for an item the box has just taken out
+     */
+    void forget(size_t index) {
+        BoxHandle handle = live[index].first;
+        generation[handle.slot] = handle.generation + 1;
+        owned[handle.slot] = false;
+        remember(handle, live[index].second);
+        live.erase(live.begin() + index);
+    }
+};
+
+/**
+ * @brief Compares a box with its model: its size, per-type counts and searches, every live and removed handle,
+ *      and iteration
+ * @return True if they match
+ */
+template <typename Box>
+static bool verify(const Subject<Box>& subject, int step) {
+    const Box& box = subject.box;
+    if (!expect(box.size() == subject.size(), "size() matches the items in the box", step)) { return false; }
+    if (!expect(box.size() <= box.capacity(), "size() is within capacity()", step)) { return false; }
+
+    for (const Kind& kind : allKinds()) {
+        int count = 0, leftmost = -1;
+        for (const auto& item : subject.live) {
+            if (item.second.getTypeId() != kind.typeId) { continue; }
+            count++;
+            int index = box.indexOf(item.first);
+            if (leftmost == -1 || index < leftmost) { leftmost = index; }
+        }
+        if (!expect(box.count(kind.typeId) == count, "count() matches the items of that type", step)) { return false; }
+        if (!expect(box.contains(kind.typeId) == (count > 0), "contains() matches count()", step)) { return false; }
+        if (!expect(box.find(kind.typeId) == leftmost, "find() returns the leftmost item of that type", step)) { return false; }
+    }
+
+    for (const auto& item : subject.live) {
+        const PieceCell* cell = box.get(item.first);
+        if (!expect(cell != nullptr && same(*cell, item.second), "every live handle gets its item", step)) { return false; }
+        int index = box.indexOf(item.first);
+        if (!expect(&box.at(index) == cell && box.handleAt(index) == item.first, "indexOf() and handleAt() agree", step)) { return false; }
+    }
+    for (const auto& item : subject.removed) {
+        bool back = std::any_of(subject.live.begin(), subject.live.end(), [&item](const std::pair<BoxHandle, PieceCell>& live) {
+            return live.first == item.first;
+        });
+        if (!expect(back || box.get(item.first) == nullptr, "removed handles are stale", step)) { return false; }
+    }
+
+    std::vector<BoxHandle> order = subject.order();
+    if (!expect(order.size() == subject.live.size(), "iteration visits every item once", step)) { return false; }
+    for (const BoxHandle& handle : order) {
+        if (!expect(box.get(handle) != nullptr, "iteration only visits live items", step)) { return false; }
+    }
+    return true;
+}
+
+/**
+ * @brief Applies one random operation to a box and its model, checking what the operation returns
+ * @return False if the operation did not do what the model expected
+ */
+template <typename Box>
+static bool mutate(Subject<Box>& subject, int step) {
+    Box& box = subject.box;
+    std::vector<BoxHandle> before = subject.order();
+    BoxHandle moved;   // An item that is added back, and so may land anywhere
+    int operation = random(0, 99);
+
+    if (operation < 30) {
+        PieceCell piece = randomPiece();
+        bool fits = subject.size() + piece.size() <= box.capacity() && subject.tracks(piece.getTypeId());
+        BoxHandle handle = box.addItem(piece);
+        if (!expect(static_cast<bool>(handle) == fits, "addItem() succeeds exactly when the item fits", step)) { return false; }
+        if (handle) {
+            if (!expect(!subject.owned[handle.slot], "addItem() hands out a free slot", step)) { return false; }
+            if (!expect(handle.generation == subject.generation[handle.slot], "addItem() keeps the slot's generation", step)) { return false; }
+            subject.owned[handle.slot] = true;
+            subject.live.push_back({handle, piece});
+        }
+    } else if (operation < 45) {
+        // The leftmost item of the type goes, found before removing since removing moves the others
+        int typeId = allKinds()[random(0, allKinds().size() - 1)].typeId;
+        int leftmost = box.find(typeId);
+        size_t index = subject.live.size();
+        for (size_t i = 0; i < subject.live.size(); i++) {
+            if (box.indexOf(subject.live[i].first) == leftmost) { index = i; }
+        }
+        bool removed = box.remove(typeId);
+        if (!expect(removed == (index < subject.live.size()), "remove(typeId) succeeds exactly when an item has the type", step)) { return false; }
+        if (removed) { subject.forget(index); }
+    } else if (operation < 60) {
+        if (subject.live.empty() || random(0, 9) == 0) {
+            // A handle that was removed already, or was never handed out, removes nothing
+            BoxHandle handle = subject.removed.empty() ? BoxHandle() : subject.removed[random(0, subject.removed.size() - 1)].first;
+            bool back = std::any_of(subject.live.begin(), subject.live.end(), [&handle](const std::pair<BoxHandle, PieceCell>& live) {
+                return live.first == handle;
+            });
+            if (!back && !expect(!box.remove(handle), "remove() of a stale handle fails", step)) { return false; }
+        } else {
+            size_t index = random(0, subject.live.size() - 1);
+            PieceCell piece = subject.live[index].second;
+            BoxHandle handle = subject.live[index].first;
+            if (!expect(box.remove(handle), "remove() of a live handle succeeds", step)) { return false; }
+            subject.forget(index);
+
+            // Undoing straight away always works, which is what ChessBox::undo relies on
+            if (random(0, 1)) {
+                if (!expect(box.restore(handle, piece), "restore() right after remove() succeeds", step)) { return false; }
+                subject.removed.pop_back();
+                subject.generation[handle.slot] = handle.generation;
+                subject.owned[handle.slot] = true;
+                subject.live.insert(subject.live.begin() + index, {handle, piece});
+                moved = handle;
+            }
+        }
+    } else if (operation < 70) {
+        if (subject.removed.empty()) { return true; }
+        size_t index = random(0, subject.removed.size() - 1);
+        BoxHandle handle = subject.removed[index].first;
+        PieceCell piece = random(0, 3) ? subject.removed[index].second : randomPiece();
+        bool expected = !subject.owned[handle.slot] && subject.generation[handle.slot] == handle.generation + 1
+            && subject.size() + piece.size() <= box.capacity() && subject.tracks(piece.getTypeId());
+        if (!expect(box.restore(handle, piece) == expected, "restore() succeeds exactly when the slot is unused since", step)) { return false; }
+        if (expected) {
+            subject.removed.erase(subject.removed.begin() + index);
+            subject.generation[handle.slot] = handle.generation;
+            subject.owned[handle.slot] = true;
+            subject.live.push_back({handle, piece});
+        }
+    } else if (operation < 82) {
+        if (subject.live.empty()) { return true; }
+        size_t index = random(0, subject.live.size() - 1);
+        PieceCell piece = randomPiece();
+        bool expected = subject.size() - subject.live[index].second.size() + piece.size() <= box.capacity()
+            && subject.tracks(piece.getTypeId());
+        if (!expect(box.replace(subject.live[index].first, piece) == expected, "replace() succeeds exactly when the new item fits", step)) { return false; }
+        if (expected) { subject.live[index].second = piece; }
+        moved = subject.live[index].first;
+    } else if (operation < 88) {
+        box.setLazyDeletion(!box.isLazyDeletion(), random(1, 4) / 4.0);
+    } else if (operation < 94) {
+        box.defragment();
+    } else if (operation < 96) {
+        box.reset();
+        for (size_t slot = 0; slot < subject.generation.size(); slot++) { subject.generation[slot] += 2; }
+        for (const auto& item : subject.live) {
+            subject.owned[item.first.slot] = false;
+            subject.remember(item.first, item.second);
+        }
+        subject.live.clear();
+    } else {
+        // Writing through at() must not reach a copy sharing the items
+        if (subject.live.empty()) { return true; }
+        size_t index = random(0, subject.live.size() - 1);
+        int row = random(0, ChessPiece::BOARD_LENGTH - 1);
+        box.at(box.indexOf(subject.live[index].first)).piece().setRow(row);
+        subject.live[index].second.piece().setRow(row);
+    }
+
+    // Nothing reorders the items that stay in the box: removing and compacting only slide them left
+    before.erase(std::remove(before.begin(), before.end(), moved), before.end());
+    std::vector<BoxHandle> after = subject.order();
+    auto kept = [](const std::vector<BoxHandle>& from, const std::vector<BoxHandle>& in) {
+        std::vector<BoxHandle> result;
+        for (const BoxHandle& handle : from) {
+            if (std::find(in.begin(), in.end(), handle) != in.end()) { result.push_back(handle); }
+        }
+        return result;
+    };
+    return expect(kept(before, after) == kept(after, before), "items keep their order", step);
+}
+
+/**
+ * @brief Runs random operations on a few boxes that start as copies of each other, so they share their storage
+ *      until one is written to. Every box is verified after every operation, which catches a write to one box
+ *      showing up in a copy.
+ * @param name The name of the check to print
+ * @param make Makes an empty box for a new sequence
+ */
+template <typename Box, typename Make>
+static void checkBoxes(const char* name, Make&& make) {
+    std::printf("%s\n", name);
+    int before = failures;
+    std::vector<Subject<Box>> subjects;
+    for (int step = 0; step < options.steps && failures == before; step++) {
+        if (subjects.empty() || random(0, 999) == 0) {
+            subjects.clear();
+            subjects.emplace_back(make());
+            if (random(0, 1)) { subjects.back().box.setLazyDeletion(true, random(1, 4) / 4.0); }
+        }
+
+        int operation = random(0, 99);
+        size_t from = random(0, subjects.size() - 1);
+        if (operation < 2 && subjects.size() < 4) {
+            subjects.push_back(subjects[from]);
+        } else if (operation < 3) {
+            size_t to = random(0, subjects.size() - 1);
+            subjects[to] = subjects[from];
+        } else if (operation < 4 && subjects.size() > 1) {
+            // A moved-from box is only good for assigning to or destroying, so it leaves the check
+            size_t to = random(0, subjects.size() - 1);
+            if (to != from) {
+                subjects[to] = std::move(subjects[from]);
+                subjects.erase(subjects.begin() + from);
+            }
+        } else {
+            mutate(subjects[from], step);
+        }
+
+        for (const Subject<Box>& subject : subjects) {
+            if (!verify(subject, step)) { break; }
+        }
+    }
+    if (failures == before) { std::printf("  ok\n"); }
+}
+
+/**
+ * @return Every piece of both players as packed words, sorted, so two positions can be compared
+ *      however the pieces are ordered within their boxes
+ */
+static std::vector<uint64_t> position(const ChessBox& box) {
+    std::vector<uint64_t> pieces;
+    for (const PieceBox* player : {&box.viewP1Pieces(), &box.viewP2Pieces()}) {
+        size_t start = pieces.size();
+        for (const PieceCell& cell : *player) { pieces.push_back(cell.pack().bits()); }
+        std::sort(pieces.begin() + start, pieces.end());
+        pieces.push_back(~uint64_t{0});
+    }
+    return pieces;
+}
+
+/**
+ * @brief Plays random games from the starting position, making and undoing random moves through the journal,
+ *      and checks every undo puts back the position and hash from before the move.
+ *      Copies of the position along the way must refuse the journal, since its moves were made on the original.
+ */
+static void checkJournal() {
+    std::printf("chessbox journal\n");
+    int before = failures;
+    ChessBox box = MoveGenerator::startPosition();
+    MoveJournal journal;
+    std::vector<std::pair<std::vector<uint64_t>, uint64_t>> history;
+
+    for (int step = 0; step < options.steps && failures == before; step++) {
+        MoveList list;
+        MoveGenerator::generate(box, history.size() % 2, list);
+        bool deeper = list.size > 0 && history.size() < 200 && (history.empty() || random(0, 2) != 0);
+        if (deeper) {
+            std::vector<uint64_t> pieces = position(box);
+            uint64_t hash = box.hash();
+            if (MoveGenerator::make(box, journal, list.moves[random(0, list.size - 1)])) { history.push_back({pieces, hash}); }
+        } else if (!history.empty()) {
+            if (random(0, 9) == 0) {
+                ChessBox copy = box;
+                expect(!copy.undo(journal) && journal.size() == static_cast<int>(history.size()), "a copy refuses the journal", step);
+            }
+            if (!expect(box.undo(journal), "undo() succeeds", step)) { break; }
+            expect(position(box) == history.back().first, "undo() puts every piece back", step);
+            expect(box.hash() == history.back().second, "undo() puts the hash back", step);
+            history.pop_back();
+        }
+    }
+    if (failures == before) { std::printf("  ok\n"); }
+}
+
+/**
+ * @brief Fills small boxes with Pawns one step from promoting, so some of their Rooks do not fit,
+ *      and checks every generated move can be made and undone, and perft(1) counts exactly those moves
+ */
+static void checkPromotions() {
+    std::printf("chessbox promotions\n");
+    int before = failures;
+    const int LAST = ChessPiece::BOARD_LENGTH - 1;
+
+    for (int step = 0; step < options.steps && failures == before; step++) {
+        ChessBox box("BLACK", "WHITE", random(1, 6));
+        for (int pawns = random(1, 4); pawns > 0; pawns--) { box.addPiece(Pawn("BLACK", LAST - 1, random(0, LAST), true)); }
+        box.addPiece(Pawn("WHITE", LAST, random(0, LAST), false));
+
+        MoveList list;
+        MoveGenerator::generate(box, 0, list);
+        MoveJournal journal;
+        for (int i = 0; i < list.size; i++) {
+            if (!expect(MoveGenerator::make(box, journal, list.moves[i]), "every generated move can be made", step)) { break; }
+            box.undo(journal);
+        }
+        expect(MoveGenerator::perft(box, 0, 1) == static_cast<uint64_t>(list.size), "perft(1) counts every move that can be made", step);
+    }
+    if (failures == before) { std::printf("  ok\n"); }
+}
+
+/**
+ * @brief Loads snapshots of the starting position with random bits of one piece word flipped, as a corrupt file
+ *      would hold them, and checks load() either refuses the snapshot or leaves every piece on a real square or none
+ */
+static void checkSnapshots() {
+    std::printf("chessbox snapshots\n");
+    int before = failures;
+    ChessSnapshot original;
+    expect(MoveGenerator::startPosition().save(original), "save() of the starting position succeeds", 0);
+
+    ChessBox box;
+    for (int step = 0; step < options.steps && failures == before; step++) {
+        ChessSnapshot snapshot = original;
+        int player = random(0, 1);
+        uint64_t& word = snapshot.pieces[player][random(0, snapshot.pieceCounts[player] - 1)];
+        for (int flips = random(1, 3); flips > 0; flips--) { word ^= uint64_t{1} << random(0, 23); }
+
+        bool loaded = box.load(snapshot);
+        if (!expect(!loaded || snapshot.isValid(), "load() refuses snapshots isValid() refuses", step)) { break; }
+        if (!loaded) { continue; }
+        for (const PieceBox* pieces : {&box.viewP1Pieces(), &box.viewP2Pieces()}) {
+            for (const PieceCell& cell : *pieces) {
+                int row = cell.piece().getRow(), col = cell.piece().getColumn();
+                expect(Board::onBoard(row, col) || (row == -1 && col == -1), "loaded pieces stand on the board or nowhere", step);
+            }
+        }
+    }
+    if (failures == before) { std::printf("  ok\n"); }
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--steps" && i + 1 < argc) {
+            options.steps = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--seed <n>] [--steps <n>]\n", argv[0]);
+            return 1;
+        }
+    }
+    std::printf("# boxtest seed=%u steps=%d\n", options.seed, options.steps);
+    rng.seed(options.seed);
+
+    BoxPool pool;
+    checkBoxes<ArrayBox<PieceCell>>("arraybox", []() { return ArrayBox<PieceCell>(random(1, 64)); });
+    checkBoxes<ArrayBox<PieceCell>>("arraybox pooled", [&pool]() { return ArrayBox<PieceCell>(random(1, 64), &pool); });
+    checkBoxes<ArrayBox<PieceCell, INLINE_CAPACITY>>("arraybox inline", []() { return ArrayBox<PieceCell, INLINE_CAPACITY>(); });
+    checkJournal();
+    checkPromotions();
+    checkSnapshots();
+
+    std::printf(failures == 0 ? "all checks passed\n" : "%d checks failed\n", failures);
+    return failures == 0 ? 0 : 1;
+}
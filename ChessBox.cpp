@@ -4,6 +4,9 @@
 // A Source files that defines ChessBox
 
 #include "ChessBox.hpp"
+#include <atomic>
+#include <cstring>
+#include <optional>
 
 /**
  * Default constructor
@@ -30,13 +33,36 @@ ChessBox::ChessBox():P1_COLOR_{"BLACK"}, P2_COLOR_{"WHITE"}, P1_BOX_{64}, P2_BOX
  *
  *       If the specified capacity is not positive (ie. <= 0) or not provided, 
  *          64 is used instead.
+ *       When built with CHESSBOX_INLINE_CAPACITY, the boxes always have that capacity and this one is ignored.
  * 
  * Also note, there are NO default values for color1 or color2 (ie. we must specify them).
  * 
  * @post Initializes ArrayBox members with the specified capacity. 
  *       All strings are initialized as described above. 
  */
-ChessBox::ChessBox(const std::string& color1, const std::string& color2, int capacity) : P1_BOX_{capacity}, P2_BOX_{capacity} {
+ChessBox::ChessBox(const std::string& color1, const std::string& color2, int capacity) : ChessBox(color1, color2, capacity, nullptr) {}
+
+/**
+ * @brief Same as the parameterized constructor above, but both players' boxes take their storage from the given pool 
+ *      (see ArrayBox's pool constructor), so creating and destroying many ChessBoxes reuses the same blocks.
+ * @param pool The pool to allocate from, which must outlive the ChessBox and all its copies. nullptr uses the heap.
+ */
+ChessBox::ChessBox(const std::string& color1, const std::string& color2, int capacity, BoxPool* pool) : 
+    P1_BOX_{capacity, pool}, P2_BOX_{capacity, pool} {
+    std::pair<std::string, std::string> colors = resolveColors(color1, color2);
+    P1_COLOR_ = colors.first;
+    P2_COLOR_ = colors.second;
+
+    board_ = Board(NameRegistry::colors().intern(P1_COLOR_), NameRegistry::colors().intern(P2_COLOR_));
+}
+
+/**
+ * @brief Applies the color rules of the parameterized constructor
+ * @param color1 A const reference to the requested color of P1
+ * @param color2 A const reference to the requested color of P2
+ * @return The colors P1 and P2 actually get, in that order
+ */
+std::pair<std::string, std::string> ChessBox::resolveColors(const std::string& color1, const std::string& color2) {
     std::string color1Upper = "";
     std::string color2Upper = "";
 
@@ -60,12 +86,27 @@ ChessBox::ChessBox(const std::string& color1, const std::string& color2, int cap
     }
 
     if (color1Upper != color1 || color2Upper != color2 || color1Upper == color2Upper) {
-        P1_COLOR_ = "BLACK";
-        P2_COLOR_ = "WHITE";
-    } else {
-        P1_COLOR_ = color1Upper;
-        P2_COLOR_ = color2Upper;
+        return {"BLACK", "WHITE"};
     }
+    return {color1Upper, color2Upper};
+}
+
+/**
+ * @param color A const reference to an uppercase color
+ * @return 0 if the color is P1_COLOR_, 1 if it is P2_COLOR_, -1 otherwise
+ */
+int ChessBox::playerOf(const std::string& color) const {
+    if (color == P1_COLOR_) { return 0; }
+    if (color == P2_COLOR_) { return 1; }
+    return -1;
+}
+
+/**
+ * @param player 0 for P1, 1 for P2
+ * @return A reference to that player's ArrayBox
+ */
+PieceBox& ChessBox::boxOf(int player) {
+    return player == 0 ? P1_BOX_ : P2_BOX_;
 }
 /**
  * @brief Getter for P1_Color
@@ -85,17 +126,39 @@ std::string ChessBox::getP2Color() const{
 
 /**
  * @brief Getter for P1_BOX
- * @return The ArrayBox<ChessPiece> (ie. the value) of P1_BOX_
+ * @return The PieceBox (ie. the value) of P1_BOX_
+ * @note The copy shares P1_BOX_'s pieces until either box changes (copy-on-write).
  */
-ArrayBox<ChessPiece> ChessBox::getP1Pieces() const{
+PieceBox ChessBox::getP1Pieces() const{
+    BOX_STAT(pieceCopies, 1);
     return P1_BOX_;
 }
 
 /**
  * @brief Getter for P2_BOX
- * @return The ArrayBox<ChessPiece> (ie. the value) of P2_BOX_
+ * @return The PieceBox (ie. the value) of P2_BOX_
+ * @note The copy shares P2_BOX_'s pieces until either box changes (copy-on-write).
+ */
+PieceBox ChessBox::getP2Pieces() const{
+    BOX_STAT(pieceCopies, 1);
+    return P2_BOX_;
+}
+
+/**
+ * @brief Read-only view of P1_BOX_ that never copies it. 
+ *      Iterate over it with a range-based for loop (or forEach) to visit every P1 piece.
+ * @return A const reference to P1_BOX_, valid for as long as this ChessBox
+ */
+const PieceBox& ChessBox::viewP1Pieces() const {
+    return P1_BOX_;
+}
+
+/**
+ * @brief Read-only view of P2_BOX_ that never copies it. 
+ *      Iterate over it with a range-based for loop (or forEach) to visit every P2 piece.
+ * @return A const reference to P2_BOX_, valid for as long as this ChessBox
  */
-ArrayBox<ChessPiece> ChessBox::getP2Pieces() const{
+const PieceBox& ChessBox::viewP2Pieces() const {
     return P2_BOX_;
 }
 
@@ -105,21 +168,74 @@ ArrayBox<ChessPiece> ChessBox::getP2Pieces() const{
  *      - If the color of the given piece matches P2_COLOR_, add it to P2_BOX_
  *      - If the color does not match either box, or the corresponding box doesn't have
  *           enough remaining space to add the piece, the add operation fails.
+ *      - If the piece is on the board and its square is already occupied, the add operation fails.
+ *      - If the piece's type ID or its player's color ID is too large for PackedPiece (which the move journal
+ *           and snapshots store pieces as), the add operation fails.
  * 
  * @param piece A const reference to a ChessPiece object 
  *              that is to be added to one of the ArrayBoxes
  * 
- * @return True if the piece was added successfully. False otherwise.
+ * @return A handle to the added piece, which tests true if the piece was added successfully and false otherwise.
  *
  */
-bool ChessBox::addPiece(const ChessPiece& piece) {
-    if (piece.getColor() == P1_COLOR_) {
-        return P1_BOX_.addItem(piece);
-    }
-    else if (piece.getColor() == P2_COLOR_) {
-        return P2_BOX_.addItem(piece);
+PieceHandle ChessBox::addPiece(const ChessPiece& piece) {
+    return insertPiece(PieceCell(piece));
+}
+
+/**
+ * @brief Same as addPiece above, but also lets the board know whether the pawn can double jump
+ * @param pawn A const reference to a Pawn that is to be added to one of the ArrayBoxes
+ * @return A handle to the added pawn, which tests true if the pawn was added successfully and false otherwise.
+ */
+PieceHandle ChessBox::addPiece(const Pawn& pawn) {
+    return insertPiece(PieceCell(pawn));
+}
+
+/**
+ * @brief Same as addPiece above, but keeps the rook's castle moves
+ * @param rook A const reference to a Rook that is to be added to one of the ArrayBoxes
+ * @return A handle to the added rook, which tests true if the rook was added successfully and false otherwise.
+ */
+PieceHandle ChessBox::addPiece(const Rook& rook) {
+    return insertPiece(PieceCell(rook));
+}
+
+/**
+ * @brief Does the work of the addPiece overloads
+ * @param cell The piece to add, wrapped with its exact type
+ */
+PieceHandle ChessBox::insertPiece(const PieceCell& cell) {
+    int player = playerOf(cell.piece().getColor());
+    if (player == -1) { return PieceHandle(); }
+
+    PieceHandle handle = insertPiece(player, cell);
+    if (handle) { version_.bump(); }
+    return handle;
+}
+
+/**
+ * @brief Same as insertPiece above, for a piece already known to belong to the given player
+ * @param player 0 for P1, 1 for P2
+ * @note Unlike insertPiece above, it leaves version_ alone, so load() bumps it once instead of once per piece
+ */
+PieceHandle ChessBox::insertPiece(int player, const PieceCell& cell) {
+    const ChessPiece& piece = cell.piece();
+    if (piece.getTypeId() < 0 || piece.getTypeId() > PackedPiece::MAX_TYPE_ID) { return PieceHandle(); }
+    if (board_.colorIdOf(player) > PackedPiece::MAX_COLOR_ID) { return PieceHandle(); }
+
+    // A piece is either on the board or has no square at all (-1, -1). Anything else would index past the board.
+    bool onBoard = Board::onBoard(piece.getRow(), piece.getColumn());
+    if (!onBoard && (piece.getRow() != -1 || piece.getColumn() != -1)) { return PieceHandle(); }
+    if (onBoard && board_.isOccupied(piece.getRow(), piece.getColumn())) { return PieceHandle(); }
+
+    BoxHandle handle = boxOf(player).addItem(cell);
+    if (!handle) { return PieceHandle(); }
+
+    if (onBoard && !placeOnBoard(player, cell, handle)) {
+        boxOf(player).remove(handle);
+        return PieceHandle();
     }
-    return false;
+    return PieceHandle{player, handle};
 }
 
 /**
@@ -133,15 +249,474 @@ bool ChessBox::addPiece(const ChessPiece& piece) {
  * 
  * @return True if a piece is found and removed. False otherwise. 
  * @note Since we require `type` and `color` to be uppercase, you need not transform it.
+ *       The type name is resolved to its ID once, then the ID overload does the work.
  */
 bool ChessBox::removePiece(const std::string& type, const std::string& color) {
-    if (color == P1_COLOR_) {
-        return P1_BOX_.remove(type);
-    } 
-    else if (color == P2_COLOR_) {
-        return P2_BOX_.remove(type);
+    int typeId = NameRegistry::pieceTypes().find(type);
+    if (typeId == NameRegistry::NOT_FOUND) { return false; }
+    return removePiece(typeId, color);
+}
+
+/**
+ * @brief Same as removePiece above, but takes the integer type ID (see NameRegistry::pieceTypes())
+ * 
+ * @param typeId An integer denoting the type ID of the ChessPiece to remove
+ * @param color A const referene to an uppercase string 
+ *             representing the color of the ChessPiece to remove
+ * @return True if a piece is found and removed. False otherwise. 
+ */
+bool ChessBox::removePiece(int typeId, const std::string& color) {
+    int player = playerOf(color);
+    if (player == -1) { return false; }
+
+    int index = boxOf(player).find(typeId);
+    if (index == -1) { return false; }
+
+    removeAt(player, index);
+    version_.bump();
+    return true;
+}
+
+/**
+ * @brief Removes the piece a handle refers to, in O(1) apart from the box's own removal cost
+ * @param handle A handle returned by addPiece()
+ * @return True if the handle was still valid and its piece was removed. False otherwise.
+ */
+bool ChessBox::removePiece(const PieceHandle& handle) {
+    if (handle.player == -1) { return false; }
+
+    int index = boxOf(handle.player).indexOf(handle.box);
+    if (index == -1) { return false; }
+
+    removeAt(handle.player, index);
+    version_.bump();
+    return true;
+}
+
+/**
+ * @brief Does the work of the removePiece overloads, once the piece has been found
+ * @param player 0 for P1, 1 for P2
+ * @param index The first cell of the piece within that player's box
+ */
+void ChessBox::removeAt(int player, int index) {
+    PieceBox& box = boxOf(player);
+
+    // Remember where the piece stood before the box shifts it away
+    int row = box.at(index).piece().getRow();
+    int col = box.at(index).piece().getColumn();
+    if (board_.lift(player, row, col)) { squareHandle_[Board::square(row, col)] = BoxHandle(); }
+
+    box.remove(box.handleAt(index));
+}
+
+/**
+ * @brief Moves the piece of the given color standing on (fromRow, fromCol) to the empty square (toRow, toCol),
+ *        updating both the piece stored in its ArrayBox and the board.
+ * 
+ * @param color A const referene to an uppercase string 
+ *             representing the color of the ChessPiece to move
+ * @return True if the piece was moved. False if there is no such piece, or the destination is off the board or occupied.
+ */
+bool ChessBox::movePiece(const std::string& color, int fromRow, int fromCol, int toRow, int toCol) {
+    int player = playerOf(color);
+    if (player == -1 || board_.playerAt(fromRow, fromCol) != player) { return false; }
+
+    // The square remembers which piece stands on it, so there is no need to search the box
+    int index = boxOf(player).indexOf(squareHandle_[Board::square(fromRow, fromCol)]);
+    if (index == -1 || !moveAt(player, index, toRow, toCol)) { return false; }
+
+    version_.bump();
+    return true;
+}
+
+/**
+ * @brief Same as movePiece above, for the piece a handle refers to
+ * @param handle A handle returned by addPiece()
+ * @return True if the piece was moved. False if the handle is no longer valid, the piece is not on the board,
+ *      or the destination is off the board or occupied.
+ */
+bool ChessBox::movePiece(const PieceHandle& handle, int toRow, int toCol) {
+    if (handle.player == -1) { return false; }
+
+    int index = boxOf(handle.player).indexOf(handle.box);
+    if (index == -1 || !moveAt(handle.player, index, toRow, toCol)) { return false; }
+
+    version_.bump();
+    return true;
+}
+
+/**
+ * @brief Does the work of the movePiece overloads, once the piece has been found
+ * @param player 0 for P1, 1 for P2
+ * @param index The first cell of the piece within that player's box
+ * @return True if the piece was moved. False if it is not on the board, or the destination is off the board or occupied.
+ */
+bool ChessBox::moveAt(int player, int index, int toRow, int toCol) {
+    PieceBox& box = boxOf(player);
+    int fromRow = box.at(index).piece().getRow();
+    int fromCol = box.at(index).piece().getColumn();
+    if (!board_.move(player, fromRow, fromCol, toRow, toCol)) { return false; }
+
+    squareHandle_[Board::square(toRow, toCol)] = squareHandle_[Board::square(fromRow, fromCol)];
+    squareHandle_[Board::square(fromRow, fromCol)] = BoxHandle();
+
+    updateCells(player, index, [toRow, toCol](PieceCell& cell) {
+        cell.piece().setRow(toRow);
+        cell.piece().setColumn(toCol);
+    });
+    return true;
+}
+
+/**
+ * @brief Swaps the squares of two pieces of the same player, on the board and in their cells
+ * @param first, second The first cells of the two pieces within that player's box. Both must be on the board.
+ */
+void ChessBox::swapAt(int player, int first, int second) {
+    PieceBox& box = boxOf(player);
+    int firstRow = box.at(first).piece().getRow(), firstCol = box.at(first).piece().getColumn();
+    int secondRow = box.at(second).piece().getRow(), secondCol = box.at(second).piece().getColumn();
+    BoxHandle firstHandle = squareHandle_[Board::square(firstRow, firstCol)];
+    BoxHandle secondHandle = squareHandle_[Board::square(secondRow, secondCol)];
+
+    board_.lift(player, firstRow, firstCol);
+    board_.lift(player, secondRow, secondCol);
+    updateCells(player, first, [secondRow, secondCol](PieceCell& cell) {
+        cell.piece().setRow(secondRow);
+        cell.piece().setColumn(secondCol);
+    });
+    updateCells(player, second, [firstRow, firstCol](PieceCell& cell) {
+        cell.piece().setRow(firstRow);
+        cell.piece().setColumn(firstCol);
+    });
+    placeOnBoard(player, box.at(first), firstHandle);
+    placeOnBoard(player, box.at(second), secondHandle);
+}
+
+/**
+ * @brief Puts a piece that is already in its box on the board, at the row and column it holds
+ * @param handle The piece's handle within that player's box, remembered for its square
+ * @return True if the piece was placed. False if Board::place refused it, in which case no handle is remembered.
+ */
+bool ChessBox::placeOnBoard(int player, const PieceCell& cell, const BoxHandle& handle) {
+    const ChessPiece& piece = cell.piece();
+    const Pawn* pawn = cell.get<Pawn>();
+    const Rook* rook = cell.get<Rook>();
+    bool doubleJumpable = pawn != nullptr && pawn->canDoubleJump();
+    int castleMoves = rook != nullptr ? rook->getCastleMovesLeft() : 0;
+    if (!board_.place(player, piece.getTypeId(), piece.getRow(), piece.getColumn(), piece.isMovingUp(), doubleJumpable, castleMoves)) {
+        return false;
     }
-    return false;
+    squareHandle_[Board::square(piece.getRow(), piece.getColumn())] = handle;
+    return true;
+}
+
+/**
+ * @return A number never returned before, and never 0
+ */
+uint64_t ChessBox::Version::next() {
+    static std::atomic<uint64_t> counter{1};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Ties the journal to this box, forgetting the moves it recorded if they were made on another box or state
+ */
+void ChessBox::bind(MoveJournal& journal) const {
+    if (journal.version_ == version_.value) { return; }
+    journal.version_ = version_.value;
+    journal.size_ = 0;
+}
+
+/**
+ * @brief Moves the piece a handle refers to onto (toRow, toCol), capturing the other player's piece if one stands there,
+ *      and records the move in the given journal so undo() can revert it. A pawn that moves loses its double jump.
+ *      It does not check that the move is legal for the piece, only that the destination is on the board 
+ *      and not occupied by the mover's own player.
+ * @param journal The journal to record the move in (see MoveJournal)
+ * @param handle A handle returned by addPiece()
+ * @param promote True to promote the mover, a Pawn reaching its last row (see Pawn::canPromote), to a Rook 
+ *      with no castle moves. The handle then refers to the Rook. Default false.
+ * @return True if the move was made. False if the handle is no longer valid, the piece is not on the board,
+ *      the destination is off the board or holds one of the mover's own pieces, the journal is full,
+ *      or promote is set but the mover is not a Pawn that would be able to promote on the destination,
+ *      or its box does not have room for the Rook. Nothing changes when it returns false.
+ */
+bool ChessBox::makeMove(MoveJournal& journal, const PieceHandle& handle, int toRow, int toCol, bool promote) {
+    bind(journal);
+    if (journal.size_ == MoveJournal::CAPACITY || handle.player == -1) { return false; }
+
+    int player = handle.player;
+    int index = boxOf(player).indexOf(handle.box);
+    if (index == -1 || !Board::onBoard(toRow, toCol) || board_.playerAt(toRow, toCol) == player) { return false; }
+
+    const PieceCell& mover = boxOf(player).at(index);
+    int fromRow = mover.piece().getRow();
+    int fromCol = mover.piece().getColumn();
+    if (!Board::onBoard(fromRow, fromCol)) { return false; }
+
+    const Pawn* pawn = mover.get<Pawn>();
+    bool lastRow = toRow == (mover.piece().isMovingUp() ? ChessPiece::BOARD_LENGTH - 1 : 0);
+    if (promote && (pawn == nullptr || !lastRow)) { return false; }
+
+    // The Rook takes more cells than the Pawn it replaces, so check it fits before anything changes
+    PieceBox& box = boxOf(player);
+    std::optional<Rook> rook;
+    if (promote) {
+        if (!hasRoomToPromote(handle)) { return false; }
+        rook.emplace(mover.piece().getColor(), toRow, toCol, mover.piece().isMovingUp(), 0);
+    }
+
+    MoveJournal::JournalEntry& entry = journal.entries_[journal.size_];
+    entry.mover = handle;
+    entry.other = handleAt(toRow, toCol);
+    entry.promoted = promote ? mover.pack() : PackedPiece();
+    entry.from = Board::square(fromRow, fromCol);
+    entry.to = Board::square(toRow, toCol);
+    entry.castle = false;
+    entry.doubleJumpCleared = false;
+
+    // The captured piece is in the other player's box, so removing it does not shift the mover
+    if (entry.other) {
+        PieceBox& enemyBox = boxOf(entry.other.player);
+        int enemyIndex = enemyBox.indexOf(entry.other.box);
+        entry.captured = enemyBox.at(enemyIndex).pack();
+        removeAt(entry.other.player, enemyIndex);
+    }
+    moveAt(player, index, toRow, toCol);
+
+    if (promote) {
+        board_.lift(player, toRow, toCol);
+        box.replace(handle.box, *rook);
+        placeOnBoard(player, *rook, handle.box);
+        journal.size_++;
+        return true;
+    }
+
+    pawn = boxOf(player).at(index).get<Pawn>();
+    if (pawn != nullptr && pawn->canDoubleJump()) {
+        updateCells(player, index, [](PieceCell& cell) { cell.get<Pawn>()->toggleDoubleJump(); });
+        board_.setDoubleJump(toRow, toCol, false);
+        entry.doubleJumpCleared = true;
+    }
+    journal.size_++;
+    return true;
+}
+
+/**
+ * @brief Castles a rook with the piece next to it (see Rook::canCastle): the two swap squares, 
+ *      and the rook uses up one of its castle moves. The castle is recorded in the given journal so undo() can revert it.
+ * @param journal The journal to record the castle in (see MoveJournal)
+ * @param rook A handle to a Rook, returned by addPiece()
+ * @param target A handle to the piece the rook castles with
+ * @return True if the castle was made. False if either handle is no longer valid, rook is not a Rook, 
+ *      the rook cannot castle with the target, or the journal is full.
+ */
+bool ChessBox::castle(MoveJournal& journal, const PieceHandle& rook, const PieceHandle& target) {
+    bind(journal);
+    if (journal.size_ == MoveJournal::CAPACITY || rook.player == -1 || rook.player != target.player) { return false; }
+
+    int player = rook.player;
+    const PieceBox& box = boxOf(player);
+    int rookIndex = box.indexOf(rook.box);
+    int targetIndex = box.indexOf(target.box);
+    if (rookIndex == -1 || targetIndex == -1 || rookIndex == targetIndex) { return false; }
+
+    const Rook* piece = box.at(rookIndex).get<Rook>();
+    if (piece == nullptr || !piece->canCastle(box.at(targetIndex).piece())) { return false; }
+
+    MoveJournal::JournalEntry& entry = journal.entries_[journal.size_];
+    entry.mover = rook;
+    entry.other = target;
+    entry.from = Board::square(piece->getRow(), piece->getColumn());
+    entry.to = Board::square(box.at(targetIndex).piece().getRow(), box.at(targetIndex).piece().getColumn());
+    entry.castle = true;
+    entry.doubleJumpCleared = false;
+
+    swapAt(player, rookIndex, targetIndex);
+    updateCells(player, rookIndex, [](PieceCell& cell) { cell.get<Rook>()->consumeCastleMove(); });
+    // The box may have unshared its cells (copy-on-write) while updating them, so look the rook up again
+    const Rook* castled = boxOf(player).at(rookIndex).get<Rook>();
+    board_.setCastleMoves(castled->getRow(), castled->getColumn(), castled->getCastleMovesLeft());
+    journal.size_++;
+    return true;
+}
+
+/**
+ * @brief Reverts the last makeMove() or castle() still in the journal, in O(1), and drops it from the journal.
+ *      The pieces, their state, the board and every handle are restored, including the handle of a captured piece.
+ *      A captured piece goes back at the end of its box, so iteration order may differ from before the capture.
+ * @param journal The journal the moves were recorded in
+ * @return True if a move was undone. False if the journal is empty, its moves were made on another box 
+ *      or this box has been changed some other way since (see MoveJournal), or a piece could not be put back 
+ *      into its box. A piece that could not be put back is left off the board too, so the board never shows 
+ *      a piece its box does not hold.
+ */
+bool ChessBox::undo(MoveJournal& journal) {
+    if (journal.size_ == 0 || journal.version_ != version_.value) { return false; }
+
+    const MoveJournal::JournalEntry& entry = journal.entries_[--journal.size_];
+    int player = entry.mover.player;
+    int index = boxOf(player).indexOf(entry.mover.box);
+    int fromRow = entry.from / ChessPiece::BOARD_LENGTH, fromCol = entry.from % ChessPiece::BOARD_LENGTH;
+    if (index == -1) { return false; }
+
+    if (entry.castle) {
+        swapAt(player, index, boxOf(player).indexOf(entry.other.box));
+        updateCells(player, index, [](PieceCell& cell) { cell.get<Rook>()->refundCastleMove(); });
+        const Rook* rook = boxOf(player).at(index).get<Rook>();
+        board_.setCastleMoves(rook->getRow(), rook->getColumn(), rook->getCastleMovesLeft());
+        return true;
+    }
+
+    // Every step is still applied if an earlier one fails, so the rest of the position is reverted either way
+    bool restored = true;
+    if (entry.promoted.bits() != 0) {
+        // The promoted pawn still holds the square it moved from, so putting it back also moves it back
+        PieceCell pawn(entry.promoted);
+        board_.lift(player, entry.to / ChessPiece::BOARD_LENGTH, entry.to % ChessPiece::BOARD_LENGTH);
+        squareHandle_[entry.to] = BoxHandle();
+        restored = boxOf(player).replace(entry.mover.box, pawn) && placeOnBoard(player, pawn, entry.mover.box);
+    } else {
+        restored = moveAt(player, index, fromRow, fromCol);
+    }
+    if (entry.doubleJumpCleared) {
+        updateCells(player, index, [](PieceCell& cell) { cell.get<Pawn>()->toggleDoubleJump(); });
+        board_.setDoubleJump(fromRow, fromCol, true);
+    }
+    if (entry.other) {
+        PieceCell captured(entry.captured);
+        if (!boxOf(entry.other.player).restore(entry.other.box, captured) || !placeOnBoard(entry.other.player, captured, entry.other.box)) {
+            restored = false;
+        }
+    }
+    return restored;
+}
+
+/**
+ * @brief Removes every piece, keeping the colors and both boxes' storage, 
+ *      so the ChessBox can be reused for another game without allocating or freeing anything.
+ * @post Every handle handed out before is invalidated
+ */
+void ChessBox::reset() {
+    P1_BOX_.reset();
+    P2_BOX_.reset();
+    board_.clear();
+    for (int square = 0; square < Board::SQUARES; square++) { squareHandle_[square] = BoxHandle(); }
+    version_.bump();
+}
+
+/**
+ * @brief Writes the colors, capacities and every piece into a fixed-layout snapshot (see ChessSnapshot), 
+ *      which can be written to a file as is with SnapshotFile::write().
+ * @param snapshot A reference to the snapshot to overwrite
+ * @return True if the snapshot was written. False if a color is too long, a box's capacity is over ChessSnapshot::MAX_CAPACITY,
+ *      a player holds more than ChessSnapshot::MAX_PIECES pieces, or a piece's type is not one of the built-in ones (see PieceType).
+ */
+bool ChessBox::save(ChessSnapshot& snapshot) const {
+    // Zeroing everything first keeps the padding and unused entries identical between saves of the same position
+    std::memset(&snapshot, 0, sizeof(ChessSnapshot));
+
+    const std::string* colors[] = {&P1_COLOR_, &P2_COLOR_};
+    const PieceBox* boxes[] = {&P1_BOX_, &P2_BOX_};
+    for (int player = 0; player < ChessSnapshot::PLAYERS; player++) {
+        if (colors[player]->size() >= static_cast<size_t>(ChessSnapshot::COLOR_LENGTH)) { return false; }
+        std::memcpy(snapshot.colors[player], colors[player]->data(), colors[player]->size());
+        if (boxes[player]->capacity() > ChessSnapshot::MAX_CAPACITY) { return false; }
+        snapshot.capacities[player] = boxes[player]->capacity();
+
+        int count = 0;
+        for (const PieceCell& cell : *boxes[player]) {
+            if (count == ChessSnapshot::MAX_PIECES || cell.getTypeId() < 0 || cell.getTypeId() > PieceType::QUEEN) { return false; }
+            snapshot.pieces[player][count++] = cell.pack().bits();
+        }
+        snapshot.pieceCounts[player] = count;
+    }
+    return true;
+}
+
+/**
+ * @brief Replaces the colors and every piece with the ones in a snapshot, eg. one mapped in place by a SnapshotFile.
+ *      Pieces are rebuilt from their packed words, with no names to look up per piece. 
+ *      Both boxes keep their storage if the snapshot has the same capacities, so a ChessBox can be reused 
+ *      to load one snapshot after another without allocating.
+ * @param snapshot A const reference to the snapshot to load
+ * @return True if the snapshot was loaded. False if it is not valid (see ChessSnapshot::isValid), 
+ *      or a piece does not fit its box or stands on an occupied square. The ChessBox is then left empty.
+ * @post Every handle handed out before is invalidated, and so is every journal of moves made before
+ */
+bool ChessBox::load(const ChessSnapshot& snapshot) {
+    reset();
+    if (!snapshot.isValid()) { return false; }
+
+    // The colors only change between games, so the registry is only consulted when they do
+    if (snapshot.color(0) != P1_COLOR_ || snapshot.color(1) != P2_COLOR_) {
+        std::pair<std::string, std::string> colors = resolveColors(std::string(snapshot.color(0)), std::string(snapshot.color(1)));
+        P1_COLOR_ = colors.first;
+        P2_COLOR_ = colors.second;
+        board_ = Board(NameRegistry::colors().intern(P1_COLOR_), NameRegistry::colors().intern(P2_COLOR_));
+    }
+    if (snapshot.capacities[0] != P1_BOX_.capacity()) { P1_BOX_ = PieceBox(snapshot.capacities[0]); }
+    if (snapshot.capacities[1] != P2_BOX_.capacity()) { P2_BOX_ = PieceBox(snapshot.capacities[1]); }
+
+    for (int player = 0; player < ChessSnapshot::PLAYERS; player++) {
+        int colorId = board_.colorIdOf(player);
+        for (int i = 0; i < snapshot.pieceCounts[player]; i++) {
+            PackedPiece packed = snapshot.piece(player, i);
+            if (!packed.setColorId(colorId) || !insertPiece(player, PieceCell(packed))) {
+                reset();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @param handle A handle returned by addPiece()
+ * @return A pointer to the piece the handle refers to, or nullptr if the handle is no longer valid
+ */
+const PieceCell* ChessBox::getPiece(const PieceHandle& handle) const {
+    if (handle.player == 0) { return P1_BOX_.get(handle.box); }
+    if (handle.player == 1) { return P2_BOX_.get(handle.box); }
+    return nullptr;
+}
+
+/**
+ * @param handle A handle returned by addPiece()
+ * @return True if the piece's box has room for the Rook that would replace it on a promotion (see makeMove),
+ *      once the piece's own cells are freed. False if it does not, or the handle is no longer valid.
+ */
+bool ChessBox::hasRoomToPromote(const PieceHandle& handle) const {
+    const PieceCell* piece = getPiece(handle);
+    if (piece == nullptr) { return false; }
+
+    const PieceBox& box = handle.player == 0 ? P1_BOX_ : P2_BOX_;
+    return box.size() - piece->size() + Rook().size() <= box.capacity();
+}
+
+/**
+ * @return A handle to the piece standing on (row, col), which tests false if the square is empty or off the board
+ */
+PieceHandle ChessBox::handleAt(int row, int col) const {
+    if (!board_.isOccupied(row, col)) { return PieceHandle(); }
+    return PieceHandle{board_.playerAt(row, col), squareHandle_[Board::square(row, col)]};
+}
+
+/**
+ * @brief Getter for the board
+ * @return A const reference to the Board mirroring where every piece stands
+ */
+const Board& ChessBox::getBoard() const {
+    return board_;
+}
+
+/**
+ * @brief The Zobrist hash of the position, kept up to date incrementally by the board (see Board::hash()).
+ *      Every add, remove, move, double jump or castle move change updates it in O(1).
+ * @return The 64-bit hash of the pieces on the board. Pieces that are not on the board do not affect it.
+ */
+uint64_t ChessBox::hash() const {
+    return board_.hash();
 }
 
 /**
@@ -155,13 +730,28 @@ bool ChessBox::removePiece(const std::string& type, const std::string& color) {
  * 
  * @return True if a piece is contained within the correct ArrayBox. False otherwise. 
  * @note Since we require `type` and `color` to be uppercase, you need not transform it.
+ *       The type name is resolved to its ID once, then the ID overload does the work.
  */
 bool ChessBox::contains(const std::string& type, const std::string &color) const {
+    int typeId = NameRegistry::pieceTypes().find(type);
+    if (typeId == NameRegistry::NOT_FOUND) { return false; }
+    return contains(typeId, color);
+}
+
+/**
+ * @brief Same as contains above, but takes the integer type ID (see NameRegistry::pieceTypes())
+ * 
+ * @param typeId An integer denoting the type ID of the ChessPiece to find
+ * @param color A const referene to an uppercase string 
+ *              representing the color of the ChessPiece to find
+ * @return True if a piece is contained within the correct ArrayBox. False otherwise. 
+ */
+bool ChessBox::contains(int typeId, const std::string &color) const {
     if (color == P1_COLOR_) {
-        return P1_BOX_.contains(type);
+        return P1_BOX_.contains(typeId);
     } 
     else if (color == P2_COLOR_) {
-        return P2_BOX_.contains(type);
+        return P2_BOX_.contains(typeId);
     }
     return false;
 }
\ No newline at end of file
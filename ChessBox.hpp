@@ -7,13 +7,182 @@
 
 #include "ArrayBox.hpp"
 #include "ChessPiece.hpp"
+#include "PieceCell.hpp"
+#include "Board.hpp"
+#include "ChessSnapshot.hpp"
 #include <cctype>
 #include <utility>
 
+// Build with -DCHESSBOX_INLINE_CAPACITY=N (N > 0) to give every ChessBox fixed-capacity boxes of N cells stored inline, 
+// so a whole ChessBox is one contiguous object with no allocation. 0 (the default) chooses the capacity at run time.
+#ifndef CHESSBOX_INLINE_CAPACITY
+#define CHESSBOX_INLINE_CAPACITY 0
+#endif
+
+using PieceBox = ArrayBox<PieceCell, CHESSBOX_INLINE_CAPACITY>;   // The box holding each player's pieces
+
+/**
+ * @struct PieceHandle
+ * @brief A stable reference to a piece in a ChessBox, returned by addPiece().
+ *      It stays valid until that piece is removed, however the other pieces are added, moved or removed.
+ */
+struct PieceHandle {
+    int player = -1;    // 0 if the piece is in P1_BOX_, 1 if it is in P2_BOX_, -1 if the add failed
+    BoxHandle box;      // The piece's handle within that player's ArrayBox
+
+    /**
+     * @return True if the handle came from a successful add (it may still have gone stale since)
+     */
+    explicit operator bool() const { return player != -1; }
+};
+
+/**
+ * @class MoveJournal
+ * @brief The moves made with ChessBox::makeMove() / castle(), which ChessBox::undo() reverts newest first.
+ *      The caller keeps it rather than the box, so copying a ChessBox never copies a journal, and one journal 
+ *      (eg. one per search thread) serves every position searched with it. Making or undoing a move never allocates.
+ *
+ * A journal belongs to the box it last recorded a move on. Once that box is changed any other way (adding, removing
+ * or moving a piece, reset(), load(), or assigning another box to it), the moves recorded so far no longer apply: 
+ * undo() refuses them, and the next move made starts the journal afresh. A copy of the box does not share the journal.
+ */
+class MoveJournal {
+    public:
+        static const int CAPACITY = 256;   // The most moves that can be made before they have to be undone
+
+        /**
+         * @return The number of moves recorded, ie. how many times undo() can be called on the box they were made on
+         *      (if it has not been changed any other way since)
+         */
+        int size() const { return size_; }
+
+        /**
+         * @brief Forgets every move recorded, keeping the position they led to
+         */
+        void clear() { size_ = 0; }
+
+    private:
+        friend class ChessBox;
+
+        /**
+         * @struct JournalEntry
+         * @brief The delta one makeMove() or castle() applied, which is all undo() needs to revert it
+         */
+        struct JournalEntry {
+            PieceHandle mover;          // The piece that moved, or for a castle the rook
+            PieceHandle other;          // The piece the move captured (invalid if none), or for a castle the piece the rook swapped with
+            PackedPiece captured;       // The captured piece as it was just before the capture
+            PackedPiece promoted;       // The mover as it was before it was promoted, or 0 if the move was not a promotion
+            int from, to;               // The mover's square (see Board::square) before and after
+            bool castle;                // Whether this entry is a castle rather than a move
+            bool doubleJumpCleared;     // Whether the move used up the mover's double jump (it was a Pawn)
+        };
+
+        JournalEntry entries_[CAPACITY];   // The moves made so far, oldest first
+        int size_ = 0;                     // The number of entries in entries_
+        uint64_t version_ = 0;             // The version of the box the moves were made on (see ChessBox::Version), 0 for none
+};
+
 class ChessBox {
     private: 
         std::string P1_COLOR_, P2_COLOR_;
-        ArrayBox<ChessPiece> P1_BOX_, P2_BOX_;
+        PieceBox P1_BOX_, P2_BOX_;   // PieceCells, so Pawns and Rooks keep their own state
+        Board board_;   // Mirrors where the pieces of both boxes stand, kept up to date by every add / remove / move
+        BoxHandle squareHandle_[Board::SQUARES];   // The handle of the piece on each occupied square, within its player's box
+
+        /**
+         * @struct Version
+         * @brief A number no other state of any ChessBox in the process has had, which ties a MoveJournal to one box.
+         *      Copying or assigning a box takes a fresh number, so moves recorded on one box never apply to a copy of it.
+         */
+        struct Version {
+            uint64_t value = next();
+
+            Version() = default;
+            Version(const Version&) : value{next()} {}
+            Version& operator=(const Version&) {
+                value = next();
+                return *this;
+            }
+
+            /**
+             * @brief Takes a fresh number, so every journal of moves made before no longer applies
+             */
+            void bump() { value = next(); }
+
+            /**
+             * @return A number never returned before, and never 0
+             */
+            static uint64_t next();
+        };
+
+        Version version_;   // Bumped by every change a MoveJournal does not record
+
+        /**
+         * @brief Ties the journal to this box, forgetting the moves it recorded if they were made on another box or state
+         */
+        void bind(MoveJournal& journal) const;
+
+        /**
+         * @param color A const reference to an uppercase color
+         * @return 0 if the color is P1_COLOR_, 1 if it is P2_COLOR_, -1 otherwise
+         */
+        int playerOf(const std::string& color) const;
+
+        /**
+         * @param player 0 for P1, 1 for P2
+         * @return A reference to that player's ArrayBox
+         */
+        PieceBox& boxOf(int player);
+
+        /**
+         * @brief Does the work of the addPiece overloads
+         * @param cell The piece to add, wrapped with its exact type
+         */
+        PieceHandle insertPiece(const PieceCell& cell);
+
+        /**
+         * @brief Same as insertPiece above, for a piece already known to belong to the given player
+         * @param player 0 for P1, 1 for P2
+         * @note Unlike insertPiece above, it leaves version_ alone, so load() bumps it once instead of once per piece
+         */
+        PieceHandle insertPiece(int player, const PieceCell& cell);
+
+        /**
+         * @brief Does the work of the removePiece overloads, once the piece has been found
+         * @param player 0 for P1, 1 for P2
+         * @param index The first cell of the piece within that player's box
+         */
+        void removeAt(int player, int index);
+
+        /**
+         * @brief Does the work of the movePiece overloads, once the piece has been found
+         * @param player 0 for P1, 1 for P2
+         * @param index The first cell of the piece within that player's box
+         * @return True if the piece was moved. False if it is not on the board, or the destination is off the board or occupied.
+         */
+        bool moveAt(int player, int index, int toRow, int toCol);
+
+        /**
+         * @brief Swaps the squares of two pieces of the same player, on the board and in their cells
+         * @param first, second The first cells of the two pieces within that player's box. Both must be on the board.
+         */
+        void swapAt(int player, int first, int second);
+
+        /**
+         * @brief Puts a piece that is already in its box on the board, at the row and column it holds
+         * @param handle The piece's handle within that player's box, remembered for its square
+         * @return True if the piece was placed. False if Board::place refused it, in which case no handle is remembered.
+         */
+        bool placeOnBoard(int player, const PieceCell& cell, const BoxHandle& handle);
+
+        /**
+         * @brief Applies the given update to every cell of a (possibly multi-cell) piece, keeping the copies identical
+         * @param index The first cell of the piece within that player's box
+         * @param update A callable taking a PieceCell&
+         */
+        template <typename Function>
+        void updateCells(int player, int index, Function&& update);
 
     public:
         /**
@@ -34,10 +203,26 @@ class ChessBox {
          *       However, if the are equal, set color1 to "BLACK" and color2 to "WHITE"
          *
          *       If the specified capacity is not positive (ie. <= 0), 64 is used instead.
+         *       When built with CHESSBOX_INLINE_CAPACITY, the boxes always have that capacity and this one is ignored.
          * 
          * @post Initializes ArrayBox members with the specified capacity. All strings are initialized as described above. 
          */
         ChessBox(const std::string& color1, const std::string& color2, int capacity = 64);
+
+        /**
+         * @brief Same as the parameterized constructor above, but both players' boxes take their storage from the given pool 
+         *      (see ArrayBox's pool constructor), so creating and destroying many ChessBoxes reuses the same blocks.
+         * @param pool The pool to allocate from, which must outlive the ChessBox and all its copies. nullptr uses the heap.
+         */
+        ChessBox(const std::string& color1, const std::string& color2, int capacity, BoxPool* pool);
+
+        /**
+         * @brief Applies the color rules of the parameterized constructor
+         * @param color1 A const reference to the requested color of P1
+         * @param color2 A const reference to the requested color of P2
+         * @return The colors P1 and P2 actually get, in that order
+         */
+        static std::pair<std::string, std::string> resolveColors(const std::string& color1, const std::string& color2);
         
         /**
          * @brief Adds a given ChessPiece object to the ArrayBox corresponding to its color:
@@ -45,12 +230,29 @@ class ChessBox {
          *      - If the color of the given piece matches P2_COLOR_, add it to P2_BOX_
          *      - If the color does not match either box, or the corresponding box doesn't have
          *           enough remaining space to add the piece, the add operation fails.
+         *      - If the piece is on the board and its square is already occupied, the add operation fails.
+         *      - If the piece's type ID or its player's color ID is too large for PackedPiece (which the move journal
+         *           and snapshots store pieces as), the add operation fails.
          * 
          * @param piece A const reference to a ChessPiece object that is to be added to one of the ArrayBoxes
-         * @return True if the piece was added successfully. False otherwise.
+         * @return A handle to the added piece, which tests true if the piece was added successfully and false otherwise.
          *
          */
-        bool addPiece(const ChessPiece& piece);
+        PieceHandle addPiece(const ChessPiece& piece);
+
+        /**
+         * @brief Same as addPiece above, but also lets the board know whether the pawn can double jump
+         * @param pawn A const reference to a Pawn that is to be added to one of the ArrayBoxes
+         * @return A handle to the added pawn, which tests true if the pawn was added successfully and false otherwise.
+         */
+        PieceHandle addPiece(const Pawn& pawn);
+
+        /**
+         * @brief Same as addPiece above, but keeps the rook's castle moves
+         * @param rook A const reference to a Rook that is to be added to one of the ArrayBoxes
+         * @return A handle to the added rook, which tests true if the rook was added successfully and false otherwise.
+         */
+        PieceHandle addPiece(const Rook& rook);
         
         /**
          * @brief Removes a ChessPiece of the given type if one exists in the ArrayBox corresponding to the given color
@@ -61,6 +263,22 @@ class ChessBox {
          */
         bool removePiece(const std::string& type, const std::string& color);
 
+        /**
+         * @brief Same as removePiece above, but takes the integer type ID (see NameRegistry::pieceTypes())
+         * 
+         * @param typeId An integer denoting the type ID of the ChessPiece to remove
+         * @param color A const referene to an uppercase string representing the color of the ChessPiece to remove
+         * @return True if a piece is found and removed. False otherwise. 
+         */
+        bool removePiece(int typeId, const std::string& color);
+
+        /**
+         * @brief Removes the piece a handle refers to, in O(1) apart from the box's own removal cost
+         * @param handle A handle returned by addPiece()
+         * @return True if the handle was still valid and its piece was removed. False otherwise.
+         */
+        bool removePiece(const PieceHandle& handle);
+
         /**
          * @brief Finds whether a ChessPiece of the given type exists within the ArrayBox corresponding to the given color
          * 
@@ -70,6 +288,130 @@ class ChessBox {
          */
         bool contains(const std::string& type, const std::string &color) const;
 
+        /**
+         * @brief Same as contains above, but takes the integer type ID (see NameRegistry::pieceTypes())
+         * 
+         * @param typeId An integer denoting the type ID of the ChessPiece to find
+         * @param color A const referene to an uppercase string representing the color of the ChessPiece to find
+         * @return True if a piece is contained within the correct ArrayBox. False otherwise. 
+         */
+        bool contains(int typeId, const std::string &color) const;
+
+        /**
+         * @brief Moves the piece of the given color standing on (fromRow, fromCol) to the empty square (toRow, toCol),
+         *        updating both the piece stored in its ArrayBox and the board.
+         * 
+         * @param color A const referene to an uppercase string representing the color of the ChessPiece to move
+         * @return True if the piece was moved. False if there is no such piece, or the destination is off the board or occupied.
+         */
+        bool movePiece(const std::string& color, int fromRow, int fromCol, int toRow, int toCol);
+
+        /**
+         * @brief Same as movePiece above, for the piece a handle refers to
+         * @param handle A handle returned by addPiece()
+         * @return True if the piece was moved. False if the handle is no longer valid, the piece is not on the board,
+         *      or the destination is off the board or occupied.
+         */
+        bool movePiece(const PieceHandle& handle, int toRow, int toCol);
+
+        /**
+         * @param handle A handle returned by addPiece()
+         * @return A pointer to the piece the handle refers to, or nullptr if the handle is no longer valid
+         */
+        const PieceCell* getPiece(const PieceHandle& handle) const;
+
+        /**
+         * @param handle A handle returned by addPiece()
+         * @return True if the piece's box has room for the Rook that would replace it on a promotion (see makeMove),
+         *      once the piece's own cells are freed. False if it does not, or the handle is no longer valid.
+         */
+        bool hasRoomToPromote(const PieceHandle& handle) const;
+
+        /**
+         * @return A handle to the piece standing on (row, col), which tests false if the square is empty or off the board
+         */
+        PieceHandle handleAt(int row, int col) const;
+
+        /**
+         * @brief Moves the piece a handle refers to onto (toRow, toCol), capturing the other player's piece if one stands there,
+         *      and records the move in the given journal so undo() can revert it. A pawn that moves loses its double jump.
+         *      It does not check that the move is legal for the piece, only that the destination is on the board 
+         *      and not occupied by the mover's own player.
+         * @param journal The journal to record the move in (see MoveJournal)
+         * @param handle A handle returned by addPiece()
+         * @param promote True to promote the mover, a Pawn reaching its last row (see Pawn::canPromote), to a Rook 
+         *      with no castle moves. The handle then refers to the Rook. Default false.
+         * @return True if the move was made. False if the handle is no longer valid, the piece is not on the board,
+         *      the destination is off the board or holds one of the mover's own pieces, the journal is full,
+         *      or promote is set but the mover is not a Pawn that would be able to promote on the destination,
+         *      or its box does not have room for the Rook. Nothing changes when it returns false.
+         */
+        bool makeMove(MoveJournal& journal, const PieceHandle& handle, int toRow, int toCol, bool promote = false);
+
+        /**
+         * @brief Castles a rook with the piece next to it (see Rook::canCastle): the two swap squares, 
+         *      and the rook uses up one of its castle moves. The castle is recorded in the given journal so undo() can revert it.
+         * @param journal The journal to record the castle in (see MoveJournal)
+         * @param rook A handle to a Rook, returned by addPiece()
+         * @param target A handle to the piece the rook castles with
+         * @return True if the castle was made. False if either handle is no longer valid, rook is not a Rook, 
+         *      the rook cannot castle with the target, or the journal is full.
+         */
+        bool castle(MoveJournal& journal, const PieceHandle& rook, const PieceHandle& target);
+
+        /**
+         * @brief Reverts the last makeMove() or castle() still in the journal, in O(1), and drops it from the journal.
+         *      The pieces, their state, the board and every handle are restored, including the handle of a captured piece.
+         *      A captured piece goes back at the end of its box, so iteration order may differ from before the capture.
+         * @param journal The journal the moves were recorded in
+         * @return True if a move was undone. False if the journal is empty, its moves were made on another box 
+         *      or this box has been changed some other way since (see MoveJournal), or a piece could not be put back 
+         *      into its box. A piece that could not be put back is left off the board too, so the board never shows 
+         *      a piece its box does not hold.
+         */
+        bool undo(MoveJournal& journal);
+
+        /**
+         * @brief Removes every piece, keeping the colors and both boxes' storage, 
+         *      so the ChessBox can be reused for another game without allocating or freeing anything.
+         * @post Every handle handed out before is invalidated
+         */
+        void reset();
+
+        /**
+         * @brief Writes the colors, capacities and every piece into a fixed-layout snapshot (see ChessSnapshot), 
+         *      which can be written to a file as is with SnapshotFile::write().
+         * @param snapshot A reference to the snapshot to overwrite
+         * @return True if the snapshot was written. False if a color is too long, a box's capacity is over ChessSnapshot::MAX_CAPACITY,
+         *      a player holds more than ChessSnapshot::MAX_PIECES pieces, or a piece's type is not one of the built-in ones (see PieceType).
+         */
+        bool save(ChessSnapshot& snapshot) const;
+
+        /**
+         * @brief Replaces the colors and every piece with the ones in a snapshot, eg. one mapped in place by a SnapshotFile.
+         *      Pieces are rebuilt from their packed words, with no names to look up per piece. 
+         *      Both boxes keep their storage if the snapshot has the same capacities, so a ChessBox can be reused 
+         *      to load one snapshot after another without allocating.
+         * @param snapshot A const reference to the snapshot to load
+         * @return True if the snapshot was loaded. False if it is not valid (see ChessSnapshot::isValid), 
+         *      or a piece does not fit its box or stands on an occupied square. The ChessBox is then left empty.
+         * @post Every handle handed out before is invalidated, and so is every journal of moves made before
+         */
+        bool load(const ChessSnapshot& snapshot);
+
+        /**
+         * @brief Getter for the board
+         * @return A const reference to the Board mirroring where every piece stands
+         */
+        const Board& getBoard() const;
+
+        /**
+         * @brief The Zobrist hash of the position, kept up to date incrementally by the board (see Board::hash()).
+         *      Every add, remove, move, double jump or castle move change updates it in O(1).
+         * @return The 64-bit hash of the pieces on the board. Pieces that are not on the board do not affect it.
+         */
+        uint64_t hash() const;
+
         /**
          * @brief Getter for P1_Color
          * @return The string value stored in P1_COLOR
@@ -84,13 +426,41 @@ class ChessBox {
 
         /**
          * @brief Getter for P1_BOX
-         * @return The ArrayBox<ChessPiece> (ie. the value) of P1_BOX_
+         * @return The PieceBox (ie. the value) of P1_BOX_
+         * @note The copy shares P1_BOX_'s pieces until either box changes (copy-on-write).
          */
-        ArrayBox<ChessPiece> getP1Pieces() const;
+        PieceBox getP1Pieces() const;
 
         /**
          * @brief Getter for P2_BOX
-         * @return The ArrayBox<ChessPiece> (ie. the value) of P2_BOX_
+         * @return The PieceBox (ie. the value) of P2_BOX_
+         * @note The copy shares P2_BOX_'s pieces until either box changes (copy-on-write).
+         */
+        PieceBox getP2Pieces() const;
+
+        /**
+         * @brief Read-only view of P1_BOX_ that never copies it. 
+         *      Iterate over it with a range-based for loop (or forEach) to visit every P1 piece.
+         * @return A const reference to P1_BOX_, valid for as long as this ChessBox
+         */
+        const PieceBox& viewP1Pieces() const;
+
+        /**
+         * @brief Read-only view of P2_BOX_ that never copies it. 
+         *      Iterate over it with a range-based for loop (or forEach) to visit every P2 piece.
+         * @return A const reference to P2_BOX_, valid for as long as this ChessBox
          */
-        ArrayBox<ChessPiece> getP2Pieces() const;
-};
\ No newline at end of file
+        const PieceBox& viewP2Pieces() const;
+};
+/**
+ * @brief Applies the given update to every cell of a (possibly multi-cell) piece, keeping the copies identical
+ * @param index The first cell of the piece within that player's box
+ * @param update A callable taking a PieceCell&
+ */
+template <typename Function>
+void ChessBox::updateCells(int player, int index, Function&& update) {
+    PieceBox& box = boxOf(player);
+    for (int cell = index, end = index + box.at(index).size(); cell < end; cell++) {
+        update(box.at(cell));
+    }
+}
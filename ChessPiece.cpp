@@ -5,6 +5,7 @@
 
 
 #include "ChessPiece.hpp"
+#include "PackedPiece.hpp"
 
 /**
 * @brief Default Constructor : All values 
@@ -15,7 +16,7 @@
 * Default piece_size: 0
 * Default type: "NONE"
 */
-ChessPiece::ChessPiece() : color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{false}, piece_size_{0}, type_{"NONE"} {} 
+ChessPiece::ChessPiece() : color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{false}, piece_size_{0}, type_id_{PieceType::NONE} {} 
 
 /**
 * @brief Parameterized constructor.
@@ -46,7 +47,16 @@ ChessPiece::ChessPiece() : color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{fal
 *
 */
 ChessPiece::ChessPiece(const std::string& color, const int& row, const int& col, const bool& movingUp, const int& piece_size, const std::string& type) :
-    color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{movingUp}, piece_size_{piece_size}, type_{type} {
+    ChessPiece(color, row, col, movingUp, piece_size, NameRegistry::pieceTypes().intern(type)) {}
+
+/**
+ * @brief Parameterized constructor taking an already resolved type ID, 
+ *        so subclasses don't have to look up their type name on every construction.
+ *        Behaves exactly as the public parameterized constructor otherwise.
+ * @param typeId The NameRegistry::pieceTypes() ID of the piece's type
+ */
+ChessPiece::ChessPiece(const std::string& color, const int& row, const int& col, const bool& movingUp, const int& piece_size, const int& typeId) :
+    color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{movingUp}, piece_size_{piece_size}, type_id_{typeId} {
         // Check for fully alphabetical string & override "BLACK" if valid color
         setColor(color);
         
@@ -56,6 +66,15 @@ ChessPiece::ChessPiece(const std::string& color, const int& row, const int& col,
         if (row_ != -1) { setColumn(col); }
     }
 
+/**
+* @brief Unpacking constructor. Rebuilds a ChessPiece from its packed form (see PackedPiece).
+*        Any subclass state in the packed word (double jump, castle moves) is ignored.
+* @param packed A const reference to the packed piece
+*/
+ChessPiece::ChessPiece(const PackedPiece& packed) :
+    color_{NameRegistry::colors().nameOf(packed.getColorId())}, row_{packed.getRow()}, column_{packed.getColumn()},
+    movingUp_{packed.isMovingUp()}, piece_size_{packed.size()}, type_id_{packed.getTypeId()} {}
+
 /**
  * @brief Gets the color of the chess piece.
  * @return The string value stored in color_
@@ -167,22 +186,60 @@ void ChessPiece::setSize(const int& size) {
 }
 
 /**
-* @brief Getter for the type_ data member
-* @return The string value stored in type_
+* @brief Getter for the name of the piece's type
+* @return A const reference to the registered name of type_id_ (eg. "PAWN")
+*/
+const std::string& ChessPiece::getType() const{
+    return NameRegistry::pieceTypes().nameOf(type_id_);
+}
+
+/**
+* @brief Getter for the type_id_ data member
+* @return The integer ID of the piece's type (see PieceType for the built-in IDs)
 */
-std::string ChessPiece::getType() const{
-    return type_;
+int ChessPiece::getTypeId() const {
+    return type_id_;
 }
+/**
+* @brief Packs this piece into a single 64-bit word (see PackedPiece)
+* @return The packed form of the piece. A color NameRegistry::colors() has never seen is registered there first.
+*      A type or color ID too large for PackedPiece is left as 0 ("NONE" / "BLACK"), which ChessBox never lets happen
+*      by refusing such pieces in addPiece().
+*/
+PackedPiece ChessPiece::pack() const {
+    // Every box interns its colors when it is created, so the color is nearly always found without registering anything
+    int colorId = NameRegistry::colors().find(color_);
+    if (colorId == NameRegistry::NOT_FOUND) { colorId = NameRegistry::colors().intern(color_); }
+
+    PackedPiece packed;
+    packed.setColorId(colorId);
+    packed.setRow(row_);
+    packed.setColumn(column_);
+    packed.setMovingUp(movingUp_);
+    packed.setSize(piece_size_);
+    packed.setTypeId(type_id_);
+    return packed;
+}
+
 /**
  * @brief Sets the type of the chess piece.
  * @param type A const reference to a string representing the new type of the chess piece 
  *      (e.g., "ROOK", "PAWN", "NONE").
  * @note This method does not validate pre-conditions 
  *      (e.g., checking for caps or symbols in the type string).
- * @post The type_ member of the ChessPiece is overridden. No value is returned.
+ * @post The type_id_ member of the ChessPiece is overridden with the interned ID of type. No value is returned.
  */
 void ChessPiece::setType(const std::string& type) {
-    type_ = type;
+    type_id_ = NameRegistry::pieceTypes().intern(type);
+}
+
+/**
+ * @brief Sets the type of the chess piece by its ID.
+ * @param typeId The NameRegistry::pieceTypes() ID of the new type of the chess piece
+ * @post The type_id_ member of the ChessPiece is overridden. No value is returned.
+ */
+void ChessPiece::setTypeId(const int& typeId) {
+    type_id_ = typeId;
 }
 /**
  * @brief Displays the chess piece's information in the following format, if it is considered on the board (ie. its row and col are not -1):
@@ -9,6 +9,9 @@
 #pragma once
 #include <iostream>
 #include <cctype>
+#include "NameRegistry.hpp"
+
+class PackedPiece;
 
 /**
  * @class ChessPiece
@@ -18,7 +21,7 @@
  */
 
 class ChessPiece {
-   protected:
+   public:
       static const int BOARD_LENGTH = 8; // A constant value representing the number of rows & columns on the chessboard
 
    private:
@@ -42,7 +45,7 @@ class ChessPiece {
       int column_;            // An integer corresponding to the column position of the chess piece
       bool movingUp_;         // A boolean representing whether the piece is moving up the board (in reference to the visual above)
       int piece_size_;        // An integer representing the size of the current chess piece
-      std::string type_;      // A string representing the type of the current chess piece
+      int type_id_;           // The NameRegistry::pieceTypes() ID of the type of the current chess piece
    public:
 
     // =============== Constructors ===============
@@ -89,6 +92,13 @@ class ChessPiece {
 
    ChessPiece(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false, const int& piece_size = 0, const std::string& type = "NONE");
 
+   /**
+   * @brief Unpacking constructor. Rebuilds a ChessPiece from its packed form (see PackedPiece).
+   *        Any subclass state in the packed word (double jump, castle moves) is ignored.
+   * @param packed A const reference to the packed piece
+   */
+   explicit ChessPiece(const PackedPiece& packed);
+
     // =============== Getters and Setters ===============
 
     /**
@@ -162,11 +172,33 @@ class ChessPiece {
    int size() const;
  
     /**
-    * @brief Getter for the type_ data member
-    * @return The string value stored in type_
+    * @brief Getter for the name of the piece's type
+    * @return A const reference to the registered name of type_id_ (eg. "PAWN")
+    */
+   const std::string& getType() const;
+
+    /**
+    * @brief Getter for the type_id_ data member
+    * @return The integer ID of the piece's type (see PieceType for the built-in IDs)
     */
-   std::string getType() const;
+   int getTypeId() const;
+
+    /**
+    * @brief Packs this piece into a single 64-bit word (see PackedPiece)
+    * @return The packed form of the piece. A color NameRegistry::colors() has never seen is registered there first.
+    *      A type or color ID too large for PackedPiece is left as 0 ("NONE" / "BLACK"), which ChessBox never lets happen
+    *      by refusing such pieces in addPiece().
+    */
+   PackedPiece pack() const;
    protected:
+      /**
+       * @brief Parameterized constructor taking an already resolved type ID, 
+       *        so subclasses don't have to look up their type name on every construction.
+       *        Behaves exactly as the public parameterized constructor otherwise.
+       * @param typeId The NameRegistry::pieceTypes() ID of the piece's type
+       */
+      ChessPiece(const std::string& color, const int& row, const int& col, const bool& movingUp, const int& piece_size, const int& typeId);
+
       /**
        * @brief Sets the size of the chess piece.
        * @param size An integer representing the new size of the chess piece.
@@ -182,7 +214,14 @@ class ChessPiece {
        *      (e.g., "ROOK", "PAWN", "NONE").
        * @note This method does not validate pre-conditions 
        *      (e.g., checking for caps or symbols in the type string).
-       * @post The type_ member of the ChessPiece is overridden. No value is returned.
+       * @post The type_id_ member of the ChessPiece is overridden with the interned ID of type. No value is returned.
        */
       void setType(const std::string& type);
+
+      /**
+       * @brief Sets the type of the chess piece by its ID.
+       * @param typeId The NameRegistry::pieceTypes() ID of the new type of the chess piece
+       * @post The type_id_ member of the ChessPiece is overridden. No value is returned.
+       */
+      void setTypeId(const int& typeId);
 };
\ No newline at end of file
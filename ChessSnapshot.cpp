@@ -0,0 +1,161 @@
+// File: ChessSnapshot.cpp
+// Author: Tahfizur Rahman
+// Date: 10/16/2026
+// A source files that defines ChessSnapshot and SnapshotFile
+
+#include "ChessSnapshot.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(SnapshotFile::Header) == 32, "The header layout is part of the file format");
+static_assert(sizeof(SnapshotFile::Header) % alignof(ChessSnapshot) == 0, "The snapshots after the header must be aligned");
+
+/**
+ * @param player 0 for P1, 1 for P2
+ * @return That player's color, viewed in place
+ */
+std::string_view ChessSnapshot::color(int player) const {
+    return std::string_view(colors[player], strnlen(colors[player], COLOR_LENGTH));
+}
+
+/**
+ * @return True if both colors are '\0'-terminated, every piece count is in [0, MAX_PIECES],
+ *      every capacity in [piece count, MAX_CAPACITY] (and positive), and every piece has a built-in type 
+ *      (see PieceType), a positive size, and either a square on the board or no square at all,
+ *      ie. the snapshot can be handed to ChessBox::load()
+ * @note Snapshots are often mapped straight from a file, so everything load() sizes an allocation by 
+ *      or indexes the board with is bounded here
+ */
+bool ChessSnapshot::isValid() const {
+    for (int player = 0; player < PLAYERS; player++) {
+        if (strnlen(colors[player], COLOR_LENGTH) == COLOR_LENGTH) { return false; }
+        if (pieceCounts[player] < 0 || pieceCounts[player] > MAX_PIECES) { return false; }
+        // Every piece takes at least one cell, so a box smaller than its piece count could never be filled
+        if (capacities[player] <= 0 || capacities[player] < pieceCounts[player] || capacities[player] > MAX_CAPACITY) { return false; }
+
+        // The packed row and column fields can hold 8 to 14 as well, which are off the board but not "not on the board"
+        for (int i = 0; i < pieceCounts[player]; i++) {
+            PackedPiece packed = piece(player, i);
+            int row = packed.getRow(), col = packed.getColumn();
+            bool onBoard = row >= 0 && row < ChessPiece::BOARD_LENGTH && col >= 0 && col < ChessPiece::BOARD_LENGTH;
+            if (!onBoard && (row != -1 || col != -1)) { return false; }
+            if (packed.size() <= 0 || packed.getTypeId() > PieceType::QUEEN) { return false; }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Default constructor. No file is open.
+ */
+SnapshotFile::SnapshotFile() : mapping_{nullptr}, length_{0}, snapshots_{nullptr}, count_{0} {}
+
+/**
+ * @brief Parameterized constructor. Same as calling open() on a default-constructed SnapshotFile.
+ * @param path A const reference to the path of the file to map. Check isOpen() to see if it worked.
+ */
+SnapshotFile::SnapshotFile(const std::string& path) : SnapshotFile() {
+    open(path);
+}
+
+/**
+ * @brief Destructor
+ * @post Unmaps the file, invalidating every reference into it
+ */
+SnapshotFile::~SnapshotFile() {
+    close();
+}
+
+/**
+ * @brief Maps the given file, closing the one open before
+ * @param path A const reference to the path of the file to map
+ * @return True if the file was mapped. False if it can not be read, is not a snapshot file,
+ *      was written with another version or byte order, or is shorter than its header says.
+ */
+bool SnapshotFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) { return false; }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    std::size_t length = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) { return false; }
+
+    const Header* header = static_cast<const Header*>(mapping);
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 && header->version == VERSION
+        && header->endianCheck == ENDIAN_CHECK && header->snapshotSize == sizeof(ChessSnapshot)
+        && header->count <= (length - sizeof(Header)) / sizeof(ChessSnapshot);
+    if (!valid) {
+        munmap(mapping, length);
+        return false;
+    }
+
+    mapping_ = mapping;
+    length_ = length;
+    snapshots_ = reinterpret_cast<const ChessSnapshot*>(static_cast<const char*>(mapping) + sizeof(Header));
+    count_ = static_cast<std::size_t>(header->count);
+    return true;
+}
+
+/**
+ * @brief Unmaps the file, if one is open
+ */
+void SnapshotFile::close() {
+    if (mapping_ == nullptr) { return; }
+
+    munmap(mapping_, length_);
+    mapping_ = nullptr;
+    length_ = 0;
+    snapshots_ = nullptr;
+    count_ = 0;
+}
+
+/**
+ * @return True if a file is mapped
+ */
+bool SnapshotFile::isOpen() const {
+    return mapping_ != nullptr;
+}
+
+/**
+ * @return The number of snapshots in the file, or 0 if none is open
+ */
+std::size_t SnapshotFile::size() const {
+    return count_;
+}
+
+/**
+ * @brief Writes the given snapshots to a file in the layout open() maps, replacing the file if it exists
+ * @param path A const reference to the path of the file to write
+ * @param snapshots The snapshots to write
+ * @param count The number of snapshots
+ * @return True if the whole file was written. False otherwise.
+ */
+bool SnapshotFile::write(const std::string& path, const ChessSnapshot* snapshots, std::size_t count) {
+    Header header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.endianCheck = ENDIAN_CHECK;
+    header.snapshotSize = sizeof(ChessSnapshot);
+    header.count = count;
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) { return false; }
+
+    bool written = std::fwrite(&header, sizeof(Header), 1, file) == 1
+        && (count == 0 || std::fwrite(snapshots, sizeof(ChessSnapshot), count, file) == count);
+    return std::fclose(file) == 0 && written;
+}
@@ -0,0 +1,151 @@
+// File: ChessSnapshot.hpp
+// Author: Tahfizur Rahman
+// Date: 10/16/2026
+// A header files that defines ChessSnapshot, a fixed-layout binary image of a ChessBox, and SnapshotFile, a file of them
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "PackedPiece.hpp"
+
+/**
+ * @struct ChessSnapshot
+ * @brief Everything a ChessBox holds (colors, capacities and every piece with its Pawn / Rook state) in a fixed layout
+ *      with no pointers, so snapshots can be written to a file as raw bytes and used in place once mapped back in.
+ *      Fill one with ChessBox::save() and apply it with ChessBox::load().
+ *
+ * Pieces are stored as PackedPiece words, in the order their box holds them. Their color field is not trusted:
+ * color IDs are only stable within one process, so the color names are stored once per player instead,
+ * and load() gives every piece its player's color.
+ * Only the built-in piece types (see PieceType) can be stored, since other type IDs are handed out at run time.
+ *
+ * The layout is that of the machine that wrote it. SnapshotFile records its byte order and refuses files from another.
+ */
+struct ChessSnapshot {
+    static const int PLAYERS = 2;
+    static const int COLOR_LENGTH = 16;   // The longest color name that fits, plus its terminating '\0'
+    static const int MAX_PIECES = 64;     // The most pieces each player's box may hold
+    static const int MAX_CAPACITY = 4096; // The largest box capacity a snapshot may ask for, so a corrupt file can not ask for gigabytes
+
+    char colors[PLAYERS][COLOR_LENGTH];      // Each player's color, '\0'-padded
+    int32_t capacities[PLAYERS];             // The capacity of each player's box
+    int32_t pieceCounts[PLAYERS];            // The number of pieces in each player's box
+    uint64_t pieces[PLAYERS][MAX_PIECES];    // PackedPiece::bits() of each piece. Entries past pieceCounts[player] are 0.
+
+    /**
+     * @param player 0 for P1, 1 for P2
+     * @return That player's color, viewed in place
+     */
+    std::string_view color(int player) const;
+
+    /**
+     * @param player 0 for P1, 1 for P2
+     * @param index An index in [0, pieceCounts[player]). It is not bounds checked.
+     * @return That piece, read in place. Its color field is whatever the writer's process used (see above).
+     */
+    PackedPiece piece(int player, int index) const { return PackedPiece(pieces[player][index]); }
+
+    /**
+     * @return True if both colors are '\0'-terminated, every piece count is in [0, MAX_PIECES],
+     *      every capacity in [piece count, MAX_CAPACITY] (and positive), and every piece has a built-in type 
+     *      (see PieceType), a positive size, and either a square on the board or no square at all,
+     *      ie. the snapshot can be handed to ChessBox::load()
+     */
+    bool isValid() const;
+};
+
+static_assert(std::is_trivially_copyable<ChessSnapshot>::value && std::is_standard_layout<ChessSnapshot>::value,
+    "A ChessSnapshot must be plain bytes to be written and mapped as is");
+static_assert(sizeof(ChessSnapshot) % alignof(uint64_t) == 0, "Snapshots in an array must all stay aligned");
+
+/**
+ * @class SnapshotFile
+ * @brief A read-only, memory-mapped file of ChessSnapshots, written by SnapshotFile::write().
+ *      Opening it checks the header and maps the file. The snapshots are then used where they sit in the mapping,
+ *      with no parsing or allocation, and pages are only read from disk as they are touched.
+ *
+ * File layout: a 32-byte Header, then `count` ChessSnapshots back to back.
+ */
+class SnapshotFile {
+    public:
+        static constexpr char MAGIC[8] = {'C', 'H', 'E', 'S', 'S', 'S', 'N', 'P'};
+        static const uint32_t VERSION = 1;                 // Bumped whenever the layout of ChessSnapshot changes
+        static const uint32_t ENDIAN_CHECK = 0x01020304;   // Read back as another value on a machine of the other byte order
+
+        struct Header {
+            char magic[8];            // MAGIC
+            uint32_t version;         // VERSION
+            uint32_t endianCheck;     // ENDIAN_CHECK, as the writer stored it
+            uint32_t snapshotSize;    // sizeof(ChessSnapshot)
+            uint32_t reserved;        // 0
+            uint64_t count;           // The number of snapshots after the header
+        };
+
+    private:
+        void* mapping_;          // The start of the mapped file, or nullptr if no file is open
+        std::size_t length_;     // The length of the mapping in bytes
+        const ChessSnapshot* snapshots_;   // The first snapshot, just past the header
+        std::size_t count_;      // The number of snapshots
+
+    public:
+        /**
+         * @brief Default constructor. No file is open.
+         */
+        SnapshotFile();
+
+        /**
+         * @brief Parameterized constructor. Same as calling open() on a default-constructed SnapshotFile.
+         * @param path A const reference to the path of the file to map. Check isOpen() to see if it worked.
+         */
+        explicit SnapshotFile(const std::string& path);
+
+        SnapshotFile(const SnapshotFile&) = delete;
+        SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+        /**
+         * @brief Destructor
+         * @post Unmaps the file, invalidating every reference into it
+         */
+        ~SnapshotFile();
+
+        /**
+         * @brief Maps the given file, closing the one open before
+         * @param path A const reference to the path of the file to map
+         * @return True if the file was mapped. False if it can not be read, is not a snapshot file,
+         *      was written with another version or byte order, or is shorter than its header says.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Unmaps the file, if one is open
+         */
+        void close();
+
+        /**
+         * @return True if a file is mapped
+         */
+        bool isOpen() const;
+
+        /**
+         * @return The number of snapshots in the file, or 0 if none is open
+         */
+        std::size_t size() const;
+
+        /**
+         * @param index An index in [0, size()). It is not bounds checked.
+         * @return The snapshot at that index, in place in the mapping. It is only valid while the file stays open.
+         */
+        const ChessSnapshot& operator[](std::size_t index) const { return snapshots_[index]; }
+
+        /**
+         * @brief Writes the given snapshots to a file in the layout open() maps, replacing the file if it exists
+         * @param path A const reference to the path of the file to write
+         * @param snapshots The snapshots to write
+         * @param count The number of snapshots
+         * @return True if the whole file was written. False otherwise.
+         */
+        static bool write(const std::string& path, const ChessSnapshot* snapshots, std::size_t count);
+};
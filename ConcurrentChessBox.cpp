@@ -0,0 +1,207 @@
+// File: ConcurrentChessBox.cpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A source files that defines ConcurrentChessBox
+
+#include "ConcurrentChessBox.hpp"
+#include <thread>
+
+/**
+ * @brief Creates an empty shard whose box has the given capacity
+ */
+ConcurrentChessBox::Shard::Shard(int capacity) : box{capacity}, sequence{0}, size{0}, occupied{0} {
+    for (int t = 0; t < Board::MAX_TYPES; t++) { typeCounts[t].store(0, std::memory_order_relaxed); }
+}
+
+/**
+ * Default constructor
+ * P1_COLOR_ is "BLACK" and P2_COLOR_ is "WHITE", and each player's box has capacity 64
+ */
+ConcurrentChessBox::ConcurrentChessBox() : ConcurrentChessBox("BLACK", "WHITE") {}
+
+/**
+ * @brief Parameterized Constructor. The colors follow the same rules as ChessBox's (see ChessBox::resolveColors).
+ * @param color1 A const reference to the color of P1's pieces
+ * @param color2 A const reference to the color of P2's pieces
+ * @param capacity The capacity of each player's box. If it is not positive (ie. <= 0), 64 is used instead.
+ */
+ConcurrentChessBox::ConcurrentChessBox(const std::string& color1, const std::string& color2, int capacity) : 
+    shards_{Shard(capacity), Shard(capacity)}, squares_{0} {
+    std::pair<std::string, std::string> colors = ChessBox::resolveColors(color1, color2);
+    P1_COLOR_ = colors.first;
+    P2_COLOR_ = colors.second;
+    colorIds_[0] = NameRegistry::colors().intern(P1_COLOR_);
+    colorIds_[1] = NameRegistry::colors().intern(P2_COLOR_);
+}
+
+/**
+ * @param color A const reference to an uppercase color
+ * @return 0 if the color is P1_COLOR_, 1 if it is P2_COLOR_, -1 otherwise
+ */
+int ConcurrentChessBox::playerOf(const std::string& color) const {
+    if (color == P1_COLOR_) { return 0; }
+    if (color == P2_COLOR_) { return 1; }
+    return -1;
+}
+
+/**
+ * @brief Makes the shard's counters odd (being written) or even (consistent) again, for snapshot()'s seqlock.
+ *      Only called while holding the shard's writer lock.
+ */
+void ConcurrentChessBox::beginWrite(Shard& shard) {
+    shard.sequence.store(shard.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void ConcurrentChessBox::endWrite(Shard& shard) {
+    shard.sequence.store(shard.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Same as ChessBox::addPiece: adds the piece to the box of its color, 
+ *      failing if neither player has its color, the box is full, or its square is taken
+ * @return True if the piece was added successfully. False otherwise.
+ */
+bool ConcurrentChessBox::addPiece(const ChessPiece& piece) {
+    return insertPiece(PieceCell(piece));
+}
+
+bool ConcurrentChessBox::addPiece(const Pawn& pawn) {
+    return insertPiece(PieceCell(pawn));
+}
+
+bool ConcurrentChessBox::addPiece(const Rook& rook) {
+    return insertPiece(PieceCell(rook));
+}
+
+/**
+ * @brief Does the work of the addPiece overloads
+ * @param cell The piece to add, wrapped with its exact type
+ */
+bool ConcurrentChessBox::insertPiece(const PieceCell& cell) {
+    const ChessPiece& piece = cell.piece();
+    int player = playerOf(piece.getColor());
+    if (player == -1) { return false; }
+
+    // Claim the square first. Whichever player sets the bit first gets it.
+    Bitboard bit = Board::onBoard(piece.getRow(), piece.getColumn()) ? Board::squareBit(piece.getRow(), piece.getColumn()) : 0;
+    if (bit != 0 && (squares_.fetch_or(bit, std::memory_order_acq_rel) & bit) != 0) { return false; }
+
+    Shard& shard = shards_[player];
+    std::lock_guard<std::mutex> lock(shard.writer);
+    if (!shard.box.addItem(cell)) {
+        squares_.fetch_and(~bit, std::memory_order_release);
+        return false;
+    }
+
+    int typeId = cell.getTypeId();
+    beginWrite(shard);
+    shard.size.store(shard.box.size(), std::memory_order_relaxed);
+    shard.occupied.store(shard.occupied.load(std::memory_order_relaxed) | bit, std::memory_order_relaxed);
+    if (typeId >= 0 && typeId < Board::MAX_TYPES) { shard.typeCounts[typeId].fetch_add(1, std::memory_order_relaxed); }
+    endWrite(shard);
+    return true;
+}
+
+/**
+ * @brief Same as ChessBox::removePiece: removes the leftmost piece of the given type from the box of the given color
+ * @return True if a piece is found and removed. False otherwise.
+ */
+bool ConcurrentChessBox::removePiece(const std::string& type, const std::string& color) {
+    int typeId = NameRegistry::pieceTypes().find(type);
+    if (typeId == NameRegistry::NOT_FOUND) { return false; }
+    return removePiece(typeId, color);
+}
+
+bool ConcurrentChessBox::removePiece(int typeId, const std::string& color) {
+    int player = playerOf(color);
+    if (player == -1) { return false; }
+
+    Shard& shard = shards_[player];
+    std::lock_guard<std::mutex> lock(shard.writer);
+    int index = shard.box.find(typeId);
+    if (index == -1) { return false; }
+
+    const ChessPiece& piece = shard.box.at(index).piece();
+    Bitboard bit = Board::onBoard(piece.getRow(), piece.getColumn()) ? Board::squareBit(piece.getRow(), piece.getColumn()) : 0;
+    shard.box.remove(typeId);
+
+    beginWrite(shard);
+    shard.size.store(shard.box.size(), std::memory_order_relaxed);
+    shard.occupied.store(shard.occupied.load(std::memory_order_relaxed) & ~bit, std::memory_order_relaxed);
+    if (typeId >= 0 && typeId < Board::MAX_TYPES) { shard.typeCounts[typeId].fetch_sub(1, std::memory_order_relaxed); }
+    endWrite(shard);
+
+    // Only free the square once the piece is gone, so nobody can claim it while it is still taken
+    squares_.fetch_and(~bit, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Same as ChessBox::contains. Lock-free for type IDs below Board::MAX_TYPES.
+ * @return True if the box of the given color holds a piece of the given type. False otherwise.
+ */
+bool ConcurrentChessBox::contains(const std::string& type, const std::string& color) const {
+    int typeId = NameRegistry::pieceTypes().find(type);
+    if (typeId == NameRegistry::NOT_FOUND) { return false; }
+    return contains(typeId, color);
+}
+
+bool ConcurrentChessBox::contains(int typeId, const std::string& color) const {
+    int player = playerOf(color);
+    if (player == -1 || typeId < 0) { return false; }
+    if (typeId < Board::MAX_TYPES) { return count(typeId, color) > 0; }
+
+    Shard& shard = const_cast<Shard&>(shards_[player]);
+    std::lock_guard<std::mutex> lock(shard.writer);
+    return shard.box.contains(typeId);
+}
+
+/**
+ * @brief Lock-free count of the pieces of one type and color
+ * @param typeId A type ID below Board::MAX_TYPES
+ * @return The number of such pieces, or 0 if the type ID or color is unknown
+ */
+int ConcurrentChessBox::count(int typeId, const std::string& color) const {
+    int player = playerOf(color);
+    if (player == -1 || typeId < 0 || typeId >= Board::MAX_TYPES) { return 0; }
+    return shards_[player].typeCounts[typeId].load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Reads all of a player's counters at one instant, without locking (see PlayerSnapshot)
+ * @return The snapshot, or an empty one if the color is unknown
+ */
+PlayerSnapshot ConcurrentChessBox::snapshot(const std::string& color) const {
+    PlayerSnapshot snapshot;
+    int player = playerOf(color);
+    if (player == -1) { return snapshot; }
+
+    const Shard& shard = shards_[player];
+    while (true) {
+        unsigned before = shard.sequence.load(std::memory_order_acquire);
+        if (before % 2 == 1) {
+            // A writer is halfway through. Let it run instead of spinning on its cache line.
+            std::this_thread::yield();
+            continue;
+        }
+
+        snapshot.size = shard.size.load(std::memory_order_relaxed);
+        snapshot.occupied = shard.occupied.load(std::memory_order_relaxed);
+        for (int t = 0; t < Board::MAX_TYPES; t++) { snapshot.typeCounts[t] = shard.typeCounts[t].load(std::memory_order_relaxed); }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (shard.sequence.load(std::memory_order_relaxed) == before) { return snapshot; }
+    }
+}
+
+/**
+ * @return The uppercase colors of P1 and P2
+ */
+std::string ConcurrentChessBox::getP1Color() const {
+    return P1_COLOR_;
+}
+
+std::string ConcurrentChessBox::getP2Color() const {
+    return P2_COLOR_;
+}
@@ -0,0 +1,141 @@
+// File: ConcurrentChessBox.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines ConcurrentChessBox, a ChessBox that many threads can use at once
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <string>
+#include "ArrayBox.hpp"
+#include "Board.hpp"
+#include "ChessBox.hpp"
+#include "PieceCell.hpp"
+
+/**
+ * @struct PlayerSnapshot
+ * @brief A consistent view of one player's pieces, all taken at the same instant
+ */
+struct PlayerSnapshot {
+    int size = 0;                           // The cells the player's pieces take up in its box
+    Bitboard occupied = 0;                  // The squares the player's pieces stand on
+    int typeCounts[Board::MAX_TYPES] = {};  // typeCounts[t] is the number of the player's pieces with type ID t
+};
+
+/**
+ * @class ConcurrentChessBox
+ * @brief The addPiece / removePiece / contains part of ChessBox, safe to call from many threads at once.
+ * 
+ * Each player's pieces live in their own shard, with its own lock, so operations on P1's pieces never wait for 
+ * operations on P2's. The only state the players share is which squares are taken, an atomic bitboard that adds 
+ * claim with a single fetch_or, so two players cannot both put a piece on the same square.
+ * 
+ * Readers never lock: contains() and count() read atomic per-type counters, and snapshot() reads a shard's counters 
+ * under a seqlock, retrying if a writer changed them halfway through. Type IDs of Board::MAX_TYPES and up have no 
+ * counter, so contains() takes the shard's lock for those.
+ * 
+ * Every shard, and the box itself, starts on its own cache line, so neither two players of one box nor two boxes 
+ * next to each other in memory (eg. in an array of games) share a line that one of them writes to.
+ * 
+ * Both colors are interned when the box is created. Pieces of any other color are rejected without touching the registry.
+ * Pieces' type names are looked up in NameRegistry::pieceTypes(), which is itself thread-safe (see NameRegistry),
+ * so boxes for many games can be created and used from a pool's workers while other threads register new names.
+ */
+class alignas(64) ConcurrentChessBox {
+    private:
+        struct alignas(64) Shard {
+            std::mutex writer;                              // Serializes the writers of this shard
+            ArrayBox<PieceCell> box;                        // Only read or written while holding writer
+
+            alignas(64) std::atomic<unsigned> sequence;     // The seqlock: odd while a writer is updating the counters below
+            std::atomic<int> size;                          // Mirrors box.size()
+            std::atomic<Bitboard> occupied;                 // The squares this player's pieces stand on
+            std::atomic<int> typeCounts[Board::MAX_TYPES];  // Mirrors box.count(t) for the type IDs that fit
+
+            explicit Shard(int capacity);
+        };
+
+        std::string P1_COLOR_, P2_COLOR_;
+        int colorIds_[Board::PLAYERS];                      // The NameRegistry::colors() ID of each player's color
+        Shard shards_[Board::PLAYERS];
+        alignas(64) std::atomic<Bitboard> squares_;         // The squares taken by either player
+
+        /**
+         * @param color A const reference to an uppercase color
+         * @return 0 if the color is P1_COLOR_, 1 if it is P2_COLOR_, -1 otherwise
+         */
+        int playerOf(const std::string& color) const;
+
+        /**
+         * @brief Does the work of the addPiece overloads
+         * @param cell The piece to add, wrapped with its exact type
+         */
+        bool insertPiece(const PieceCell& cell);
+
+        /**
+         * @brief Makes the shard's counters odd (being written) or even (consistent) again, for snapshot()'s seqlock.
+         *      Only called while holding the shard's writer lock.
+         */
+        static void beginWrite(Shard& shard);
+        static void endWrite(Shard& shard);
+
+    public:
+        /**
+         * Default constructor
+         * P1_COLOR_ is "BLACK" and P2_COLOR_ is "WHITE", and each player's box has capacity 64
+         */
+        ConcurrentChessBox();
+
+        /**
+         * @brief Parameterized Constructor. The colors follow the same rules as ChessBox's (see ChessBox::resolveColors).
+         * @param color1 A const reference to the color of P1's pieces
+         * @param color2 A const reference to the color of P2's pieces
+         * @param capacity The capacity of each player's box. If it is not positive (ie. <= 0), 64 is used instead.
+         */
+        ConcurrentChessBox(const std::string& color1, const std::string& color2, int capacity = 64);
+
+        ConcurrentChessBox(const ConcurrentChessBox&) = delete;
+        ConcurrentChessBox& operator=(const ConcurrentChessBox&) = delete;
+
+        /**
+         * @brief Same as ChessBox::addPiece: adds the piece to the box of its color, 
+         *      failing if neither player has its color, the box is full, or its square is taken
+         * @return True if the piece was added successfully. False otherwise.
+         */
+        bool addPiece(const ChessPiece& piece);
+        bool addPiece(const Pawn& pawn);
+        bool addPiece(const Rook& rook);
+
+        /**
+         * @brief Same as ChessBox::removePiece: removes the leftmost piece of the given type from the box of the given color
+         * @return True if a piece is found and removed. False otherwise.
+         */
+        bool removePiece(const std::string& type, const std::string& color);
+        bool removePiece(int typeId, const std::string& color);
+
+        /**
+         * @brief Same as ChessBox::contains. Lock-free for type IDs below Board::MAX_TYPES.
+         * @return True if the box of the given color holds a piece of the given type. False otherwise.
+         */
+        bool contains(const std::string& type, const std::string& color) const;
+        bool contains(int typeId, const std::string& color) const;
+
+        /**
+         * @brief Lock-free count of the pieces of one type and color
+         * @param typeId A type ID below Board::MAX_TYPES
+         * @return The number of such pieces, or 0 if the type ID or color is unknown
+         */
+        int count(int typeId, const std::string& color) const;
+
+        /**
+         * @brief Reads all of a player's counters at one instant, without locking (see PlayerSnapshot)
+         * @return The snapshot, or an empty one if the color is unknown
+         */
+        PlayerSnapshot snapshot(const std::string& color) const;
+
+        /**
+         * @return The uppercase colors of P1 and P2
+         */
+        std::string getP1Color() const;
+        std::string getP2Color() const;
+};
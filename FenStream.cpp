@@ -0,0 +1,357 @@
+// File: FenStream.cpp
+// Author: Tahfizur Rahman
+// Date: 10/16/2026
+// A source files that defines FenReader and FenWriter
+
+#include "FenStream.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+/**
+ * @return The packed form of a default Pawn / Rook (see their default constructors),
+ *      which every piece read starts from before its square and state are set
+ */
+static PackedPiece defaultPawn() {
+    static const PackedPiece pawn = Pawn().pack();
+    return pawn;
+}
+
+static PackedPiece defaultRook() {
+    static const PackedPiece rook = Rook().pack();
+    return rook;
+}
+
+/**
+ * @brief Reads from an already open file (eg. stdin), which is left open
+ */
+FenReader::FenReader(FILE* file) :
+    file_{file}, ownsFile_{false}, buffer_(BUFFER_SIZE), begin_{0}, end_{0}, eof_{false}, discarding_{false},
+    snapshot_{}, positions_{0}, skipped_{0} {}
+
+/**
+ * @brief Opens the file at the given path, and closes it when destroyed. Check isOpen() to see if it worked.
+ */
+FenReader::FenReader(const std::string& path) : FenReader(std::fopen(path.c_str(), "rb")) {
+    ownsFile_ = file_ != nullptr;
+}
+
+FenReader::~FenReader() {
+    if (ownsFile_) { std::fclose(file_); }
+}
+
+/**
+ * @return True if there is a file to read from
+ */
+bool FenReader::isOpen() const {
+    return file_ != nullptr;
+}
+
+/**
+ * @brief Finds the next line, reading another chunk when the buffer runs out
+ * @param line Set to the line, without its '\n', viewed in place in the buffer
+ * @return True if there was a line. False at the end of the file.
+ */
+bool FenReader::nextLine(std::string_view& line) {
+    while (true) {
+        const char* start = buffer_.data() + begin_;
+        const char* newline = static_cast<const char*>(std::memchr(start, '\n', end_ - begin_));
+        if (newline != nullptr) {
+            std::size_t length = newline - start;
+            begin_ += length + 1;
+            if (discarding_) {
+                discarding_ = false;
+                continue;
+            }
+            line = std::string_view(start, length);
+            return true;
+        }
+
+        if (eof_) {
+            if (begin_ == end_ || discarding_) { return false; }
+            line = std::string_view(start, end_ - begin_);
+            begin_ = end_;
+            return true;
+        }
+
+        // Keep the partial line at the front and read the next chunk after it.
+        // A line that already fills the whole buffer is too long to parse, so the rest of it is skipped as it is read.
+        if (discarding_ || (begin_ == 0 && end_ == buffer_.size())) {
+            if (!discarding_) { skipped_++; }
+            discarding_ = true;
+            begin_ = end_ = 0;
+        } else {
+            std::memmove(buffer_.data(), start, end_ - begin_);
+            end_ -= begin_;
+            begin_ = 0;
+        }
+
+        std::size_t read = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+        end_ += read;
+        if (read == 0) { eof_ = true; }
+    }
+}
+
+/**
+ * @brief Parses a line into snapshot_'s pieces and counts
+ * @return True if the line is a well-formed position
+ */
+bool FenReader::parse(std::string_view line) {
+    std::string_view fields[3];
+    int fieldCount = 0;
+    for (std::size_t start = line.find_first_not_of(' '); start != std::string_view::npos; start = line.find_first_not_of(' ', start)) {
+        if (fieldCount == 3) { return false; }
+        std::size_t end = std::min(line.find(' ', start), line.size());
+        fields[fieldCount++] = line.substr(start, end - start);
+        start = end;
+    }
+    if (fieldCount == 0) { return false; }
+
+    // Rows: each piece goes at the end of its player's list, so the lists follow the order of the line
+    snapshot_.pieceCounts[0] = snapshot_.pieceCounts[1] = 0;
+    std::fill(pieceAt_, pieceAt_ + Board::SQUARES, -1);
+    int rooks[Board::SQUARES];   // The pieceAt_ codes of the rooks, in the order they appear
+    int rookCount = 0;
+
+    const int LENGTH = ChessPiece::BOARD_LENGTH;
+    int row = 0, col = 0;
+    for (char c : fields[0]) {
+        if (c == '/') {
+            if (col != LENGTH || row == LENGTH - 1) { return false; }
+            row++;
+            col = 0;
+        } else if (c >= '1' && c <= '8') {
+            col += c - '0';
+            if (col > LENGTH) { return false; }
+        } else {
+            int player = (c == 'P' || c == 'R') ? 1 : 0;
+            char lower = static_cast<char>(c | 0x20);
+            if ((lower != 'p' && lower != 'r') || col == LENGTH) { return false; }
+
+            PackedPiece piece = lower == 'p' ? defaultPawn() : defaultRook();
+            piece.setRow(row);
+            piece.setColumn(col);
+            piece.setMovingUp(player == 0);
+
+            int index = snapshot_.pieceCounts[player]++;
+            int code = player * ChessSnapshot::MAX_PIECES + index;
+            snapshot_.pieces[player][index] = piece.bits();
+            pieceAt_[Board::square(row, col)] = code;
+            if (lower == 'r') { rooks[rookCount++] = code; }
+            col++;
+        }
+    }
+    if (row != LENGTH - 1 || col != LENGTH) { return false; }
+
+    // Double jumps: pairs of a column letter and a row digit, each naming a pawn
+    if (fieldCount >= 2 && fields[1] != "-") {
+        if (fields[1].size() % 2 != 0) { return false; }
+        for (std::size_t i = 0; i < fields[1].size(); i += 2) {
+            int pawnCol = fields[1][i] - 'a', pawnRow = fields[1][i + 1] - '1';
+            if (!Board::onBoard(pawnRow, pawnCol)) { return false; }
+
+            int code = pieceAt_[Board::square(pawnRow, pawnCol)];
+            if (code == -1) { return false; }
+            uint64_t& bits = snapshot_.pieces[code / ChessSnapshot::MAX_PIECES][code % ChessSnapshot::MAX_PIECES];
+            PackedPiece pawn(bits);
+            if (pawn.getTypeId() != PieceType::PAWN) { return false; }
+            pawn.setDoubleJump(true);
+            bits = pawn.bits();
+        }
+    }
+
+    // Castle moves: one number per rook, separated by ','
+    if (fieldCount == 3 && fields[2] != "-") {
+        const char* next = fields[2].data();
+        const char* end = next + fields[2].size();
+        for (int i = 0; i < rookCount; i++) {
+            if (i > 0) {
+                if (next == end || *next != ',') { return false; }
+                next++;
+            }
+            int moves;
+            std::from_chars_result result = std::from_chars(next, end, moves);
+            if (result.ec != std::errc()) { return false; }
+            next = result.ptr;
+
+            uint64_t& bits = snapshot_.pieces[rooks[i] / ChessSnapshot::MAX_PIECES][rooks[i] % ChessSnapshot::MAX_PIECES];
+            PackedPiece rook(bits);
+            rook.setCastleMovesLeft(moves);
+            bits = rook.bits();
+        }
+        if (next != end) { return false; }
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the next position into the given box, replacing everything in it but its colors and capacity.
+ *      Lines that are not well-formed, or whose pieces do not fit the box, are skipped (see skipped()).
+ * @param box A reference to the box to fill. Lowercase pieces go to P1 and uppercase ones to P2.
+ * @return True if a position was read. False once the file has run out.
+ */
+bool FenReader::next(ChessBox& box) {
+    if (file_ == nullptr) { return false; }
+
+    std::string_view line;
+    while (nextLine(line)) {
+        if (!line.empty() && line.back() == '\r') { line.remove_suffix(1); }
+        if (line.empty() || line[0] == '#') { continue; }
+
+        // The box keeps its colors and capacities, so load() reuses its storage and never looks a color up
+        std::string colors[] = {box.getP1Color(), box.getP2Color()};
+        const PieceBox* boxes[] = {&box.viewP1Pieces(), &box.viewP2Pieces()};
+        bool fits = colors[0].size() < ChessSnapshot::COLOR_LENGTH && colors[1].size() < ChessSnapshot::COLOR_LENGTH;
+        for (int player = 0; fits && player < ChessSnapshot::PLAYERS; player++) {
+            std::memset(snapshot_.colors[player], 0, ChessSnapshot::COLOR_LENGTH);
+            std::memcpy(snapshot_.colors[player], colors[player].data(), colors[player].size());
+            snapshot_.capacities[player] = boxes[player]->capacity();
+        }
+
+        if (fits && parse(line) && box.load(snapshot_)) {
+            positions_++;
+            return true;
+        }
+        skipped_++;
+    }
+    return false;
+}
+
+/**
+ * @return The number of positions read so far
+ */
+uint64_t FenReader::positions() const {
+    return positions_;
+}
+
+/**
+ * @return The number of non-empty lines skipped so far because they could not be read
+ */
+uint64_t FenReader::skipped() const {
+    return skipped_;
+}
+
+/**
+ * @brief Writes to an already open file (eg. stdout), which is left open
+ */
+FenWriter::FenWriter(FILE* file) : file_{file}, ownsFile_{false}, buffer_(BUFFER_SIZE), size_{0} {}
+
+/**
+ * @brief Creates (or replaces) the file at the given path, and closes it when destroyed. Check isOpen() to see if it worked.
+ */
+FenWriter::FenWriter(const std::string& path) : FenWriter(std::fopen(path.c_str(), "wb")) {
+    ownsFile_ = file_ != nullptr;
+}
+
+/**
+ * @brief Destructor
+ * @post Flushes anything still buffered
+ */
+FenWriter::~FenWriter() {
+    flush();
+    if (ownsFile_) { std::fclose(file_); }
+}
+
+/**
+ * @return True if there is a file to write to
+ */
+bool FenWriter::isOpen() const {
+    return file_ != nullptr;
+}
+
+/**
+ * @brief Appends a position as one line
+ * @param box A const reference to the position. P1's pieces are written in lowercase and P2's in uppercase.
+ * @return True if the line was buffered. False if a piece is off the board or is not a Pawn or Rook,
+ *      or an earlier write to the file failed.
+ */
+bool FenWriter::write(const ChessBox& box) {
+    if (file_ == nullptr) { return false; }
+    if (buffer_.size() - size_ <= MAX_LINE && !flush()) { return false; }
+
+    std::size_t length = format(box, buffer_.data() + size_);
+    if (length == 0) { return false; }
+    size_ += length;
+    buffer_[size_++] = '\n';
+    return true;
+}
+
+/**
+ * @brief Writes everything buffered to the file
+ * @return True if it was all written
+ */
+bool FenWriter::flush() {
+    if (file_ == nullptr) { return false; }
+
+    bool written = std::fwrite(buffer_.data(), 1, size_, file_) == size_;
+    size_ = 0;
+    return std::fflush(file_) == 0 && written;
+}
+
+/**
+ * @brief Formats a position as one line, without the '\n'
+ * @param box A const reference to the position
+ * @param out Where to write the line, with room for at least MAX_LINE characters
+ * @return The length of the line, or 0 if the position can not be written (see write())
+ */
+std::size_t FenWriter::format(const ChessBox& box, char* out) {
+    // Lay the pieces out on a grid first, since the rows and both state fields are written in square order
+    PackedPiece grid[Board::SQUARES];
+    int owner[Board::SQUARES];
+    std::fill(owner, owner + Board::SQUARES, -1);
+
+    const PieceBox* boxes[] = {&box.viewP1Pieces(), &box.viewP2Pieces()};
+    for (int player = 0; player < ChessSnapshot::PLAYERS; player++) {
+        for (const PieceCell& cell : *boxes[player]) {
+            PackedPiece piece = cell.pack();
+            int typeId = piece.getTypeId();
+            if (!piece.isOnBoard() || (typeId != PieceType::PAWN && typeId != PieceType::ROOK)) { return 0; }
+
+            int square = Board::square(piece.getRow(), piece.getColumn());
+            grid[square] = piece;
+            owner[square] = player;
+        }
+    }
+
+    const int LENGTH = ChessPiece::BOARD_LENGTH;
+    char* next = out;
+    for (int row = 0; row < LENGTH; row++) {
+        if (row > 0) { *next++ = '/'; }
+        int empty = 0;
+        for (int col = 0; col < LENGTH; col++) {
+            int square = Board::square(row, col);
+            if (owner[square] == -1) {
+                empty++;
+                continue;
+            }
+            if (empty > 0) { *next++ = static_cast<char>('0' + empty); }
+            empty = 0;
+
+            char letter = grid[square].getTypeId() == PieceType::PAWN ? 'p' : 'r';
+            *next++ = owner[square] == 1 ? static_cast<char>(letter - 'a' + 'A') : letter;
+        }
+        if (empty > 0) { *next++ = static_cast<char>('0' + empty); }
+    }
+
+    *next++ = ' ';
+    char* field = next;
+    for (int square = 0; square < Board::SQUARES; square++) {
+        if (owner[square] != -1 && grid[square].getTypeId() == PieceType::PAWN && grid[square].canDoubleJump()) {
+            *next++ = static_cast<char>('a' + grid[square].getColumn());
+            *next++ = static_cast<char>('1' + grid[square].getRow());
+        }
+    }
+    if (next == field) { *next++ = '-'; }
+
+    *next++ = ' ';
+    field = next;
+    for (int square = 0; square < Board::SQUARES; square++) {
+        if (owner[square] != -1 && grid[square].getTypeId() == PieceType::ROOK) {
+            if (next != field) { *next++ = ','; }
+            next = std::to_chars(next, out + MAX_LINE, grid[square].getCastleMovesLeft()).ptr;
+        }
+    }
+    if (next == field) { *next++ = '-'; }
+
+    return next - out;
+}
@@ -0,0 +1,172 @@
+// File: FenStream.hpp
+// Author: Tahfizur Rahman
+// Date: 10/16/2026
+// A header files that defines FenReader and FenWriter, which stream positions in a FEN-like text notation
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ChessBox.hpp"
+#include "ChessSnapshot.hpp"
+
+/**
+ * The notation holds one position per line, as up to three fields separated by spaces:
+ *
+ *      <rows> [<double jumps> [<castle moves>]]
+ *
+ *  - rows: the 8 rows of the board separated by '/', row 0 first. Each row lists its columns from 0 to 7:
+ *      'p' / 'r' is a pawn / rook of P1, 'P' / 'R' a pawn / rook of P2, and a digit 1-8 skips that many empty squares.
+ *  - double jumps: the squares of the pawns that can still double jump, each as a column letter a-h
+ *      followed by a row digit 1-8 (row + 1), eg. "a2b2". "-" or a missing field means none.
+ *  - castle moves: the castle moves left of each rook, in the order the rooks appear in <rows>, separated by ','.
+ *      "-" or a missing field gives every rook 3.
+ *
+ * P1's pieces move up and P2's move down, as in MoveGenerator::startPosition(), which is:
+ *      rr4rr/pppppppp/8/8/8/8/PPPPPPPP/RR4RR a2b2c2d2e2f2g2h2a7b7c7d7e7f7g7h7 3,3,3,3,3,3,3,3
+ *
+ * Only Pawns and Rooks on the board can be written. Empty lines and lines starting with '#' are skipped.
+ */
+
+/**
+ * @class FenReader
+ * @brief Reads positions in the notation above from a file (or stdin) in large buffered chunks,
+ *      and fills a reusable ChessBox with each one in turn.
+ *      Lines are tokenized as string_views into the buffer, and each position goes into the box through a ChessSnapshot
+ *      (see ChessBox::load), so nothing is allocated per token, per piece or, once the box has its storage, per position.
+ */
+class FenReader {
+    public:
+        static const std::size_t BUFFER_SIZE = 1 << 20;   // The bytes read from the file at a time. Longer lines are skipped.
+
+    private:
+        FILE* file_;                // The file being read, or nullptr if it could not be opened
+        bool ownsFile_;             // Whether the destructor closes file_
+        std::vector<char> buffer_;  // The last chunk read, of which [begin_, end_) has not been parsed yet
+        std::size_t begin_, end_;
+        bool eof_;                  // Whether the whole file has been read into buffer_
+        bool discarding_;           // Whether the rest of a line too long for the buffer is being skipped
+
+        ChessSnapshot snapshot_;            // The position being parsed, handed to ChessBox::load
+        int pieceAt_[Board::SQUARES];       // The index in snapshot_.pieces of the piece on each square, plus 64 for P2, or -1
+        uint64_t positions_, skipped_;      // The number of lines read into a box, and of lines that could not be
+
+        /**
+         * @brief Finds the next line, reading another chunk when the buffer runs out
+         * @param line Set to the line, without its '\n', viewed in place in the buffer
+         * @return True if there was a line. False at the end of the file.
+         */
+        bool nextLine(std::string_view& line);
+
+        /**
+         * @brief Parses a line into snapshot_'s pieces and counts
+         * @return True if the line is a well-formed position
+         */
+        bool parse(std::string_view line);
+
+    public:
+        /**
+         * @brief Reads from an already open file (eg. stdin), which is left open
+         */
+        explicit FenReader(FILE* file);
+
+        /**
+         * @brief Opens the file at the given path, and closes it when destroyed. Check isOpen() to see if it worked.
+         */
+        explicit FenReader(const std::string& path);
+
+        FenReader(const FenReader&) = delete;
+        FenReader& operator=(const FenReader&) = delete;
+
+        ~FenReader();
+
+        /**
+         * @return True if there is a file to read from
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Reads the next position into the given box, replacing everything in it but its colors and capacity.
+         *      Lines that are not well-formed, or whose pieces do not fit the box, are skipped (see skipped()).
+         * @param box A reference to the box to fill. Lowercase pieces go to P1 and uppercase ones to P2.
+         * @return True if a position was read. False once the file has run out.
+         */
+        bool next(ChessBox& box);
+
+        /**
+         * @return The number of positions read so far
+         */
+        uint64_t positions() const;
+
+        /**
+         * @return The number of non-empty lines skipped so far because they could not be read
+         */
+        uint64_t skipped() const;
+};
+
+/**
+ * @class FenWriter
+ * @brief Writes positions in the notation above to a file (or stdout), one line each.
+ *      Lines are formatted straight into a large buffer, which is written out whenever it fills up and when flushed.
+ */
+class FenWriter {
+    public:
+        static const std::size_t BUFFER_SIZE = 1 << 20;   // The bytes gathered before writing them to the file
+        static const std::size_t MAX_LINE = 1024;         // More than the longest line a position can take
+
+    private:
+        FILE* file_;                // The file being written, or nullptr if it could not be opened
+        bool ownsFile_;             // Whether the destructor closes file_
+        std::vector<char> buffer_;  // The first size_ bytes have not been written to the file yet
+        std::size_t size_;
+
+    public:
+        /**
+         * @brief Writes to an already open file (eg. stdout), which is left open
+         */
+        explicit FenWriter(FILE* file);
+
+        /**
+         * @brief Creates (or replaces) the file at the given path, and closes it when destroyed. Check isOpen() to see if it worked.
+         */
+        explicit FenWriter(const std::string& path);
+
+        FenWriter(const FenWriter&) = delete;
+        FenWriter& operator=(const FenWriter&) = delete;
+
+        /**
+         * @brief Destructor
+         * @post Flushes anything still buffered
+         */
+        ~FenWriter();
+
+        /**
+         * @return True if there is a file to write to
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Appends a position as one line
+         * @param box A const reference to the position. P1's pieces are written in lowercase and P2's in uppercase.
+         * @return True if the line was buffered. False if a piece is off the board or is not a Pawn or Rook,
+         *      or an earlier write to the file failed.
+         */
+        bool write(const ChessBox& box);
+
+        /**
+         * @brief Writes everything buffered to the file
+         * @return True if it was all written
+         */
+        bool flush();
+
+        /**
+         * @brief Formats a position as one line, without the '\n'
+         * @param box A const reference to the position
+         * @param out Where to write the line, with room for at least MAX_LINE characters
+         * @return The length of the line, or 0 if the position can not be written (see write())
+         */
+        static std::size_t format(const ChessBox& box, char* out);
+};
@@ -0,0 +1,204 @@
+// File: MoveGenerator.cpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A source files that defines MoveGenerator
+
+#include "MoveGenerator.hpp"
+
+/**
+ * @brief Appends a move for every destination in the given set, each coming from the square `shift` bits before it.
+ *      Promotions whose Rook does not fit in the pawn's box are left out.
+ * @param destinations The destination squares
+ * @param shift The destination's bit index minus the origin's
+ * @param lastRow The row on which the pawns are promoted, as a bitboard
+ */
+static void addPawnMoves(const ChessBox& box, Bitboard destinations, int shift, Bitboard lastRow, MoveList& list) {
+    while (destinations != 0) {
+        int to = __builtin_ctzll(destinations);
+        destinations &= destinations - 1;
+
+        int from = to - shift;
+        PieceHandle pawn = box.handleAt(from / ChessPiece::BOARD_LENGTH, from % ChessPiece::BOARD_LENGTH);
+        bool promotion = (lastRow >> to) & 1;
+        // A promotion whose Rook does not fit in the pawn's box could not be made, so it is not a move
+        if (promotion && !box.hasRoomToPromote(pawn)) { continue; }
+
+        Move& move = list.moves[list.size++];
+        move.piece = pawn;
+        move.partner = PieceHandle();
+        move.toRow = to / ChessPiece::BOARD_LENGTH;
+        move.toCol = to % ChessPiece::BOARD_LENGTH;
+        move.promotion = promotion;
+    }
+}
+
+/**
+ * @brief Appends every move available to the given player to the list
+ * @param box A const reference to the position
+ * @param player The index of the player to move (0 for P1, 1 for P2)
+ * @param list The list to append to
+ */
+void MoveGenerator::generate(const ChessBox& box, int player, MoveList& list) {
+    const Board& board = box.getBoard();
+    const int ROW = ChessPiece::BOARD_LENGTH;
+
+    // Pawns, set-wise. Moving up adds a row to the bit index, moving down subtracts one.
+    PawnMoves up, down;
+    Pawn::generate(board, player, up, down);
+    for (const PawnMoves* moves : {&up, &down}) {
+        int forward = moves->movingUp ? ROW : -ROW;
+        Bitboard lastRow = Bitboard{0xFF} << (moves->movingUp ? Board::SQUARES - ROW : 0);
+        addPawnMoves(box, moves->singlePushes, forward, lastRow, list);
+        addPawnMoves(box, moves->doublePushes, 2 * forward, lastRow, list);
+        addPawnMoves(box, moves->capturesWest, forward - 1, lastRow, list);
+        addPawnMoves(box, moves->capturesEast, forward + 1, lastRow, list);
+    }
+
+    // Rooks, one at a time through the magic-bitboard tables
+    Bitboard own = board.occupiedBy(player);
+    Bitboard rooks = board.pieces(player, PieceType::ROOK);
+    while (rooks != 0) {
+        int from = __builtin_ctzll(rooks);
+        rooks &= rooks - 1;
+
+        int row = from / ROW, col = from % ROW;
+        PieceHandle rook = box.handleAt(row, col);
+        Bitboard destinations = Rook::attacks(from, board.occupied()) & ~own;
+        while (destinations != 0) {
+            int to = __builtin_ctzll(destinations);
+            destinations &= destinations - 1;
+
+            Move& move = list.moves[list.size++];
+            move.piece = rook;
+            move.partner = PieceHandle();
+            move.toRow = to / ROW;
+            move.toCol = to % ROW;
+            move.promotion = false;
+        }
+
+        // A castle swaps the rook with a piece of its own color right next to it on the same row
+        if (board.castleMovesAt(row, col) <= 0) { continue; }
+        for (int partnerCol : {col - 1, col + 1}) {
+            if (board.playerAt(row, partnerCol) != player) { continue; }
+
+            Move& move = list.moves[list.size++];
+            move.piece = rook;
+            move.partner = box.handleAt(row, partnerCol);
+            move.toRow = row;
+            move.toCol = partnerCol;
+            move.promotion = false;
+        }
+    }
+}
+
+/**
+ * @brief Makes a generated move on the box, recording it in the journal so ChessBox::undo() reverts it
+ * @return True if the move was made. False if it no longer applies (see ChessBox::makeMove and ChessBox::castle).
+ */
+bool MoveGenerator::make(ChessBox& box, MoveJournal& journal, const Move& move) {
+    if (move.partner) { return box.castle(journal, move.piece, move.partner); }
+    return box.makeMove(journal, move.piece, move.toRow, move.toCol, move.promotion);
+}
+
+/**
+ * @brief Does the work of both perft overloads, making and undoing every move through one journal
+ */
+static uint64_t countLeaves(ChessBox& box, MoveJournal& journal, int player, int depth) {
+    if (depth == 0) { return 1; }
+
+    MoveList list;
+    MoveGenerator::generate(box, player, list);
+
+    // Every generated move can be made (see generate), so the last ply only has to count them
+    if (depth == 1) { return list.size; }
+
+    uint64_t nodes = 0;
+    for (int i = 0; i < list.size; i++) {
+        // A move that could not be made left nothing in the journal to undo
+        if (!MoveGenerator::make(box, journal, list.moves[i])) { continue; }
+        nodes += countLeaves(box, journal, 1 - player, depth - 1);
+        box.undo(journal);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Counts the leaf nodes of the game tree from the given position, down to the given depth,
+ *      with the players taking turns. The box is left as it was.
+ * @param box A reference to the position
+ * @param player The index of the player to move first (0 for P1, 1 for P2)
+ * @param depth The number of moves (plies) to look ahead, at most MoveJournal::CAPACITY
+ * @return The number of positions reached after exactly depth moves. 1 if depth is 0.
+ */
+uint64_t MoveGenerator::perft(ChessBox& box, int player, int depth) {
+    MoveJournal journal;
+    return countLeaves(box, journal, player, depth);
+}
+
+/**
+ * @brief Same count as perft above, spread over a pool of worker threads.
+ *      Every pair of first and second moves becomes one task, so there are enough tasks to keep every worker busy.
+ *      Each worker searches its tasks on its own copy of the position, with its own journal, and keeps its own count.
+ *      The counts are added up once the pool has run every task.
+ * @param box A const reference to the position. It is copied, never changed.
+ * @param pool The worker threads to search on
+ */
+uint64_t MoveGenerator::perft(const ChessBox& box, int player, int depth, WorkStealingPool& pool) {
+    ChessBox root(box);
+    if (depth < 3) { return perft(root, player, depth); }
+
+    // One cache line per count, so workers adding to their own do not slow each other down
+    struct alignas(64) Count { uint64_t nodes = 0; };
+    std::vector<Count> counts(pool.size());
+    std::vector<ChessBox> boxes(pool.size(), root);
+    std::vector<MoveJournal> journals(pool.size());
+    MoveJournal rootJournal;
+
+    // Handles are the same in every copy of the position, so moves generated on root apply to every worker's box
+    std::vector<WorkStealingPool::Task> tasks;
+    MoveList first;
+    generate(root, player, first);
+    for (int i = 0; i < first.size; i++) {
+        if (!make(root, rootJournal, first.moves[i])) { continue; }
+        MoveList second;
+        generate(root, 1 - player, second);
+        for (int j = 0; j < second.size; j++) {
+            tasks.push_back([&counts, &boxes, &journals, player, depth, one = first.moves[i], two = second.moves[j]](int worker) {
+                ChessBox& position = boxes[worker];
+                MoveJournal& journal = journals[worker];
+                if (!make(position, journal, one)) { return; }
+                if (make(position, journal, two)) {
+                    counts[worker].nodes += countLeaves(position, journal, player, depth - 2);
+                    position.undo(journal);
+                }
+                position.undo(journal);
+            });
+        }
+        root.undo(rootJournal);
+    }
+    pool.run(std::move(tasks));
+
+    uint64_t nodes = 0;
+    for (const Count& count : counts) { nodes += count.nodes; }
+    return nodes;
+}
+
+/**
+ * @brief Sets up the starting position perft uses by default: each player has Rooks on the four
+ *      outermost squares of their back row and a Pawn that can double jump on every square of the row in front.
+ *      P1 ("BLACK") starts on rows 0 and 1 moving up, P2 ("WHITE") on rows 7 and 6 moving down.
+ * @return The starting position
+ */
+ChessBox MoveGenerator::startPosition() {
+    const int LAST = ChessPiece::BOARD_LENGTH - 1;
+    ChessBox box("BLACK", "WHITE");
+    for (int col = 0; col <= LAST; col++) {
+        box.addPiece(Pawn("BLACK", 1, col, true, true));
+        box.addPiece(Pawn("WHITE", LAST - 1, col, false, true));
+    }
+    for (int col : {0, 1, LAST - 1, LAST}) {
+        box.addPiece(Rook("BLACK", 0, col, true));
+        box.addPiece(Rook("WHITE", LAST, col, false));
+    }
+    return box;
+}
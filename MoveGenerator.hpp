@@ -0,0 +1,88 @@
+// File: MoveGenerator.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines Move, MoveList and MoveGenerator, which enumerate the moves of a ChessBox position
+
+#pragma once
+#include <cstdint>
+#include "ChessBox.hpp"
+#include "WorkStealingPool.hpp"
+
+/**
+ * @struct Move
+ * @brief One move of one piece, as makeMove() / castle() on a ChessBox take it
+ */
+struct Move {
+    PieceHandle piece;          // The piece that moves, or for a castle the rook
+    PieceHandle partner;        // For a castle, the piece the rook swaps with. Invalid otherwise.
+    int toRow = -1, toCol = -1; // The destination. For a castle, the partner's square.
+    bool promotion = false;     // Whether a Pawn reaching its last row is promoted to a Rook
+};
+
+/**
+ * @struct MoveList
+ * @brief A fixed-capacity list of moves, so generating moves never allocates
+ */
+struct MoveList {
+    static const int MAX_MOVES = 1024;   // More than two full boxes of rooks can make in one position
+
+    Move moves[MAX_MOVES];
+    int size = 0;
+};
+
+/**
+ * @class MoveGenerator
+ * @brief Enumerates the moves available to a player, for the pieces that have movement rules:
+ *      - Pawns push one square forward, two if they can still double jump, and capture one square diagonally forward.
+ *        A Pawn reaching its last row is always promoted to a Rook, so it cannot move there if its box has no room
+ *        for the Rook (see ChessBox::hasRoomToPromote).
+ *      - Rooks slide along their row and column (see Rook::attacks), capturing the first enemy piece in each direction,
+ *        and castle with an adjacent piece of their own color (see Rook::canCastle).
+ *      Other pieces (plain ChessPieces) do not move.
+ * 
+ * There is no king, so every move generated is legal, and every one can be made on the box it was generated from.
+ */
+class MoveGenerator {
+    public:
+        /**
+         * @brief Appends every move available to the given player to the list
+         * @param box A const reference to the position
+         * @param player The index of the player to move (0 for P1, 1 for P2)
+         * @param list The list to append to
+         */
+        static void generate(const ChessBox& box, int player, MoveList& list);
+
+        /**
+         * @brief Makes a generated move on the box, recording it in the journal so ChessBox::undo() reverts it
+         * @return True if the move was made. False if it no longer applies (see ChessBox::makeMove and ChessBox::castle).
+         */
+        static bool make(ChessBox& box, MoveJournal& journal, const Move& move);
+
+        /**
+         * @brief Counts the leaf nodes of the game tree from the given position, down to the given depth,
+         *      with the players taking turns. The box is left as it was.
+         * @param box A reference to the position
+         * @param player The index of the player to move first (0 for P1, 1 for P2)
+         * @param depth The number of moves (plies) to look ahead, at most MoveJournal::CAPACITY
+         * @return The number of positions reached after exactly depth moves. 1 if depth is 0.
+         */
+        static uint64_t perft(ChessBox& box, int player, int depth);
+
+        /**
+         * @brief Same count as perft above, spread over a pool of worker threads.
+         *      Every pair of first and second moves becomes one task, so there are enough tasks to keep every worker busy.
+         *      Each worker searches its tasks on its own copy of the position and keeps its own count.
+         *      The counts are added up once the pool has run every task.
+         * @param box A const reference to the position. It is copied, never changed.
+         * @param pool The worker threads to search on
+         */
+        static uint64_t perft(const ChessBox& box, int player, int depth, WorkStealingPool& pool);
+
+        /**
+         * @brief Sets up the starting position perft uses by default: each player has Rooks on the four
+         *      outermost squares of their back row and a Pawn that can double jump on every square of the row in front.
+         *      P1 ("BLACK") starts on rows 0 and 1 moving up, P2 ("WHITE") on rows 7 and 6 moving down.
+         * @return The starting position
+         */
+        static ChessBox startPosition();
+};
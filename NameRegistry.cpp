@@ -0,0 +1,86 @@
+// File: NameRegistry.cpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A source files that defines NameRegistry
+
+#include "NameRegistry.hpp"
+#include <mutex>
+
+/**
+ * @brief Parameterized constructor
+ * @param names The names to pre-register, in order. The first one gets ID 0.
+ */
+NameRegistry::NameRegistry(std::initializer_list<std::string> names) {
+    for (const std::string& name : names) {
+        intern(name);
+    }
+}
+
+/**
+ * @brief Looks up the ID of the given name, registering it if it was not seen before.
+ * @param name A const reference to the name to intern
+ * @return The ID of the name
+ */
+int NameRegistry::intern(const std::string& name) {
+    int known = find(name);
+    if (known != NOT_FOUND) { return known; }
+
+    // Another thread may have registered the name between the two locks
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto found = ids_.find(name);
+    if (found != ids_.end()) { return found->second; }
+
+    int id = static_cast<int>(names_.size());
+    names_.push_back(name);
+    ids_.emplace(name, id);
+    return id;
+}
+
+/**
+ * @brief Looks up the ID of the given name without registering it
+ * @param name A const reference to the name to find
+ * @return The ID of the name, or NOT_FOUND if it was never registered
+ */
+int NameRegistry::find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto found = ids_.find(name);
+    return found == ids_.end() ? NOT_FOUND : found->second;
+}
+
+/**
+ * @brief Gets the name registered under the given ID
+ * @param id An ID previously returned by intern()
+ * @return A const reference to the registered name. 
+ *         Unknown IDs resolve to the name registered under ID 0.
+ */
+const std::string& NameRegistry::nameOf(int id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id < 0 || id >= static_cast<int>(names_.size())) { return names_[0]; }
+    return names_[id];
+}
+
+/**
+ * @return The number of names registered so far
+ */
+int NameRegistry::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return static_cast<int>(names_.size());
+}
+
+/**
+ * @brief The registry shared by all chess pieces for their types.
+ *        Comes pre-registered with "NONE", "PAWN", "ROOK" and "QUEEN" (see PieceType).
+ */
+NameRegistry& NameRegistry::pieceTypes() {
+    static NameRegistry registry{"NONE", "PAWN", "ROOK", "QUEEN"};
+    return registry;
+}
+
+/**
+ * @brief The registry shared by all chess pieces for their (uppercase) colors.
+ *        Comes pre-registered with "BLACK" (ID 0) and "WHITE" (ID 1).
+ */
+NameRegistry& NameRegistry::colors() {
+    static NameRegistry registry{"BLACK", "WHITE"};
+    return registry;
+}
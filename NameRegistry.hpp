@@ -0,0 +1,88 @@
+// File: NameRegistry.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines NameRegistry, which interns strings into small integer IDs
+
+#pragma once
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <initializer_list>
+
+/**
+ * @struct PieceType
+ * @brief The IDs of the built-in piece types. These are always registered, in this order,
+ *        so they can be compared against without ever touching the registry.
+ */
+struct PieceType {
+    static constexpr int NONE = 0;
+    static constexpr int PAWN = 1;
+    static constexpr int ROOK = 2;
+    static constexpr int QUEEN = 3;
+};
+
+/**
+ * @class NameRegistry
+ * @brief Maps names (eg. "PAWN", "ROOK") to small, dense integer IDs and back.
+ * 
+ * IDs are handed out in registration order starting at 0 and never change 
+ * for the lifetime of the program, so they can be stored and compared in place of the name.
+ * 
+ * A registry is thread-safe: lookups share a lock and only registering a new name takes it exclusively.
+ * Names are never moved once registered, so the references nameOf() returns stay valid as more names are added.
+ */
+class NameRegistry {
+    private:
+        std::deque<std::string> names_;              // names_[id] is the name registered under id
+        std::unordered_map<std::string, int> ids_;   // The reverse mapping of names_
+        mutable std::shared_mutex mutex_;            // Guards names_ and ids_
+
+    public:
+        static constexpr int NOT_FOUND = -1;
+
+        /**
+         * @brief Parameterized constructor
+         * @param names The names to pre-register, in order. The first one gets ID 0.
+         */
+        NameRegistry(std::initializer_list<std::string> names);
+
+        /**
+         * @brief Looks up the ID of the given name, registering it if it was not seen before.
+         * @param name A const reference to the name to intern
+         * @return The ID of the name
+         */
+        int intern(const std::string& name);
+
+        /**
+         * @brief Looks up the ID of the given name without registering it
+         * @param name A const reference to the name to find
+         * @return The ID of the name, or NOT_FOUND if it was never registered
+         */
+        int find(const std::string& name) const;
+
+        /**
+         * @brief Gets the name registered under the given ID
+         * @param id An ID previously returned by intern()
+         * @return A const reference to the registered name. 
+         *         Unknown IDs resolve to the name registered under ID 0.
+         */
+        const std::string& nameOf(int id) const;
+
+        /**
+         * @return The number of names registered so far
+         */
+        int size() const;
+
+        /**
+         * @brief The registry shared by all chess pieces for their types.
+         *        Comes pre-registered with "NONE", "PAWN", "ROOK" and "QUEEN" (see PieceType).
+         */
+        static NameRegistry& pieceTypes();
+
+        /**
+         * @brief The registry shared by all chess pieces for their (uppercase) colors.
+         *        Comes pre-registered with "BLACK" (ID 0) and "WHITE" (ID 1).
+         */
+        static NameRegistry& colors();
+};
@@ -0,0 +1,148 @@
+// File: PackedPiece.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines PackedPiece, a ChessPiece packed into one 64-bit word
+
+#pragma once
+#include <cstdint>
+#include "ChessPiece.hpp"
+
+/**
+ * @class PackedPiece
+ * @brief Stores everything a ChessPiece, Pawn or Rook knows in a single 64-bit word,
+ *        so the items of an ArrayBox<PackedPiece> take 8 bytes per cell (the box's bookkeeping arrays add 29 more, see BoxLayout).
+ *        Only type IDs up to MAX_TYPE_ID and color IDs up to MAX_COLOR_ID fit. setTypeId and setColorId refuse larger ones.
+ * 
+ * Bit layout (lowest bit first):
+ *    [ 0,  4)  row + 1      (0 means the piece is not on the board)
+ *    [ 4,  8)  column + 1   (0 means the piece is not on the board)
+ *    [ 8,  9)  movingUp
+ *    [ 9, 10)  double_jumpable (Pawn only)
+ *    [10, 16)  piece size
+ *    [16, 24)  type ID  (NameRegistry::pieceTypes())
+ *    [24, 40)  color ID (NameRegistry::colors())
+ *    [40, 56)  castle moves left (Rook only, saturates at 0xFFFF)
+ * 
+ * The getters and setters mirror the ones on ChessPiece, and are defined here in the header
+ * since the whole point of this class is that they compile down to a shift and a mask.
+ */
+class PackedPiece {
+    private:
+        static constexpr int ROW_SHIFT = 0;
+        static constexpr int COLUMN_SHIFT = 4;
+        static constexpr int MOVING_UP_SHIFT = 8;
+        static constexpr int DOUBLE_JUMP_SHIFT = 9;
+        static constexpr int SIZE_SHIFT = 10;
+        static constexpr int TYPE_SHIFT = 16;
+        static constexpr int COLOR_SHIFT = 24;
+        static constexpr int CASTLE_SHIFT = 40;
+
+        static constexpr uint64_t POSITION_MASK = 0xF;
+        static constexpr uint64_t SIZE_MASK = 0x3F;
+        static constexpr uint64_t TYPE_MASK = 0xFF;
+        static constexpr uint64_t COLOR_MASK = 0xFFFF;
+        static constexpr uint64_t CASTLE_MASK = 0xFFFF;
+
+        uint64_t bits_;
+
+        constexpr uint64_t field(int shift, uint64_t mask) const { return (bits_ >> shift) & mask; }
+        constexpr void setField(int shift, uint64_t mask, uint64_t value) {
+            bits_ = (bits_ & ~(mask << shift)) | ((value & mask) << shift);
+        }
+
+    public:
+        static constexpr int MAX_TYPE_ID = static_cast<int>(TYPE_MASK);     // The largest type ID the type field holds
+        static constexpr int MAX_COLOR_ID = static_cast<int>(COLOR_MASK);   // The largest color ID the color field holds
+
+        /**
+         * @brief Default constructor. Matches ChessPiece(): a "BLACK", "NONE" piece of size 0 that is not on the board.
+         *        Both "BLACK" and "NONE" are registered under ID 0, so this is the all-zero word.
+         */
+        constexpr PackedPiece() : bits_{0} {}
+
+        /**
+         * @brief Wraps an already packed word (eg. one read back from bits())
+         */
+        constexpr explicit PackedPiece(uint64_t bits) : bits_{bits} {}
+
+        /**
+         * @return The raw 64-bit word
+         */
+        constexpr uint64_t bits() const { return bits_; }
+
+        constexpr int getRow() const { return static_cast<int>(field(ROW_SHIFT, POSITION_MASK)) - 1; }
+        constexpr int getColumn() const { return static_cast<int>(field(COLUMN_SHIFT, POSITION_MASK)) - 1; }
+        constexpr bool isMovingUp() const { return field(MOVING_UP_SHIFT, 1) != 0; }
+        constexpr bool canDoubleJump() const { return field(DOUBLE_JUMP_SHIFT, 1) != 0; }
+        constexpr int size() const { return static_cast<int>(field(SIZE_SHIFT, SIZE_MASK)); }
+        constexpr int getTypeId() const { return static_cast<int>(field(TYPE_SHIFT, TYPE_MASK)); }
+        constexpr int getColorId() const { return static_cast<int>(field(COLOR_SHIFT, COLOR_MASK)); }
+        constexpr int getCastleMovesLeft() const { return static_cast<int>(field(CASTLE_SHIFT, CASTLE_MASK)); }
+
+        /**
+         * @return True if both the row and column are on the board
+         */
+        constexpr bool isOnBoard() const { return field(ROW_SHIFT, POSITION_MASK) != 0 && field(COLUMN_SHIFT, POSITION_MASK) != 0; }
+
+        /**
+         * @brief Sets the row. As with ChessPiece::setRow, a value outside [0, BOARD_LENGTH) 
+         *        takes the piece off the board, setting both its row AND column to -1.
+         */
+        constexpr void setRow(int row) {
+            if (row < 0 || row >= ChessPiece::BOARD_LENGTH) {
+                setField(ROW_SHIFT, POSITION_MASK, 0);
+                setField(COLUMN_SHIFT, POSITION_MASK, 0);
+                return;
+            }
+            setField(ROW_SHIFT, POSITION_MASK, row + 1);
+        }
+
+        /**
+         * @brief Sets the column. As with ChessPiece::setColumn, a value outside [0, BOARD_LENGTH) 
+         *        takes the piece off the board, setting both its row AND column to -1.
+         */
+        constexpr void setColumn(int column) {
+            if (column < 0 || column >= ChessPiece::BOARD_LENGTH) {
+                setField(ROW_SHIFT, POSITION_MASK, 0);
+                setField(COLUMN_SHIFT, POSITION_MASK, 0);
+                return;
+            }
+            setField(COLUMN_SHIFT, POSITION_MASK, column + 1);
+        }
+
+        constexpr void setMovingUp(bool flag) { setField(MOVING_UP_SHIFT, 1, flag); }
+        constexpr void setDoubleJump(bool flag) { setField(DOUBLE_JUMP_SHIFT, 1, flag); }
+        constexpr void setSize(int size) { setField(SIZE_SHIFT, SIZE_MASK, static_cast<uint64_t>(size)); }
+
+        /**
+         * @brief Sets the type ID, unless it is outside [0, MAX_TYPE_ID]
+         * @return True if the type ID was stored. False if it does not fit, in which case the piece is unchanged.
+         */
+        constexpr bool setTypeId(int typeId) {
+            if (typeId < 0 || typeId > MAX_TYPE_ID) { return false; }
+            setField(TYPE_SHIFT, TYPE_MASK, static_cast<uint64_t>(typeId));
+            return true;
+        }
+
+        /**
+         * @brief Sets the color ID, unless it is outside [0, MAX_COLOR_ID]
+         * @return True if the color ID was stored. False if it does not fit, in which case the piece is unchanged.
+         */
+        constexpr bool setColorId(int colorId) {
+            if (colorId < 0 || colorId > MAX_COLOR_ID) { return false; }
+            setField(COLOR_SHIFT, COLOR_MASK, static_cast<uint64_t>(colorId));
+            return true;
+        }
+
+        /**
+         * @brief Sets the number of castle moves left. Negative values are stored as 0, 
+         *        and values that don't fit in 16 bits are stored as 0xFFFF.
+         */
+        constexpr void setCastleMovesLeft(int moves) {
+            uint64_t clamped = moves < 0 ? 0 : (static_cast<uint64_t>(moves) > CASTLE_MASK ? CASTLE_MASK : static_cast<uint64_t>(moves));
+            setField(CASTLE_SHIFT, CASTLE_MASK, clamped);
+        }
+
+        constexpr bool operator==(const PackedPiece& other) const { return bits_ == other.bits_; }
+        constexpr bool operator!=(const PackedPiece& other) const { return bits_ != other.bits_; }
+};
@@ -15,7 +15,7 @@
  */
 Pawn::Pawn() : ChessPiece(), double_jumpable_{false} {
     setSize(1);
-    setType("PAWN");
+    setTypeId(PieceType::PAWN);
 }
 
 /**
@@ -33,7 +33,23 @@ Pawn::Pawn() : ChessPiece(), double_jumpable_{false} {
 * 2) The type member is set to "PAWN"
 */
 Pawn::Pawn(const std::string& color, const int& row, const int& col, const bool& movingUp, const bool& double_jumpable) :
-    ChessPiece(color, row, col, movingUp, 1, "PAWN"), double_jumpable_{double_jumpable} {}
+    ChessPiece(color, row, col, movingUp, 1, PieceType::PAWN), double_jumpable_{double_jumpable} {}
+
+/**
+ * @brief Unpacking constructor. Rebuilds a Pawn, including its double_jumpable_ flag, from its packed form.
+ * @param packed A const reference to the packed pawn
+ */
+Pawn::Pawn(const PackedPiece& packed) : ChessPiece(packed), double_jumpable_{packed.canDoubleJump()} {}
+
+/**
+ * @brief Packs this pawn, including its double_jumpable_ flag, into a single 64-bit word
+ * @return The packed form of the pawn
+ */
+PackedPiece Pawn::pack() const {
+    PackedPiece packed = ChessPiece::pack();
+    packed.setDoubleJump(double_jumpable_);
+    return packed;
+}
 
 /**
  * @brief Gets the value of the flag for the Pawn can double jump
@@ -61,4 +77,61 @@ void Pawn::toggleDoubleJump() {
 bool Pawn::canPromote() const {
     return (isMovingUp() && getRow() == BOARD_LENGTH - 1) || 
         (!isMovingUp() && getRow() == 0);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Same rule as canPromote() above, evaluated directly on a packed pawn
+ * @param pawn A const reference to the packed pawn
+ * @return True if the pawn can be promoted. False otherwise.
+ */
+bool Pawn::canPromote(const PackedPiece& pawn) {
+    return (pawn.isMovingUp() && pawn.getRow() == BOARD_LENGTH - 1) || 
+        (!pawn.isMovingUp() && pawn.getRow() == 0);
+}
+
+/**
+ * @brief Computes the moves of a whole set of pawns at once with shift-and-mask bitboard operations.
+ * @param pawns The squares of the pawns, all moving in the same direction
+ * @param doubleJumpable The squares of the pawns that can double jump (other squares are ignored)
+ * @param movingUp The direction the pawns move in (see ChessPiece::isMovingUp)
+ * @param empty The empty squares of the board
+ * @param enemies The squares occupied by pieces the pawns can capture
+ * @return The destinations of every push, double push, capture and promotion
+ */
+PawnMoves Pawn::generate(Bitboard pawns, Bitboard doubleJumpable, bool movingUp, Bitboard empty, Bitboard enemies) {
+    const Bitboard FIRST_COLUMN = 0x0101010101010101ULL;
+    const Bitboard LAST_COLUMN = FIRST_COLUMN << (BOARD_LENGTH - 1);
+    const Bitboard FIRST_ROW = 0xFFULL;
+    const Bitboard LAST_ROW = FIRST_ROW << (BOARD_LENGTH * (BOARD_LENGTH - 1));
+
+    // Moving one row forward is a shift by a whole row, up or down
+    auto forward = [movingUp](Bitboard squares, int columns) {
+        return movingUp ? (squares << (BOARD_LENGTH + columns)) : (squares >> (BOARD_LENGTH - columns));
+    };
+
+    PawnMoves moves;
+    moves.movingUp = movingUp;
+    moves.singlePushes = forward(pawns, 0) & empty;
+    moves.doublePushes = forward(forward(pawns & doubleJumpable, 0) & empty, 0) & empty;
+    moves.capturesWest = forward(pawns & ~FIRST_COLUMN, -1) & enemies;
+    moves.capturesEast = forward(pawns & ~LAST_COLUMN, 1) & enemies;
+    moves.promotions = (moves.singlePushes | moves.capturesWest | moves.capturesEast) & (movingUp ? LAST_ROW : FIRST_ROW);
+    return moves;
+}
+
+/**
+ * @brief Computes the moves of all of a player's pawns on the given board. Since every pawn has 
+ *     its own movingUp_ flag, the pawns moving up and those moving down are generated separately.
+ * @param board A const reference to the board
+ * @param player The index of the player whose pawns move (0 for P1, 1 for P2)
+ * @param up Set to the moves of the player's pawns moving up
+ * @param down Set to the moves of the player's pawns moving down
+ */
+void Pawn::generate(const Board& board, int player, PawnMoves& up, PawnMoves& down) {
+    Bitboard pawns = board.pieces(player, PieceType::PAWN);
+    Bitboard empty = ~board.occupied();
+    Bitboard enemies = board.occupiedBy(1 - player);
+
+    up = generate(pawns & board.movingUp(), board.doubleJumpable(), true, empty, enemies);
+    down = generate(pawns & ~board.movingUp(), board.doubleJumpable(), false, empty, enemies);
+}
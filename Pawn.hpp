@@ -8,6 +8,24 @@
 
 #include <iostream>
 #include "ChessPiece.hpp"
+#include "PackedPiece.hpp"
+#include "Board.hpp"
+
+/**
+ * @struct PawnMoves
+ * @brief The destination squares of every move available to a set of pawns moving in the same direction.
+ *     Since all of the pawns move the same way, the origin of each destination is found by shifting it back:
+ *     a single push came from one row behind it, a double push from two rows behind it,
+ *     and a capture towards the lower (West) / higher (East) column from one row behind and one column East / West.
+ */
+struct PawnMoves {
+    bool movingUp = false;          // The direction all of these pawns move in
+    Bitboard singlePushes = 0;      // One square forward onto an empty square
+    Bitboard doublePushes = 0;      // Two squares forward over an empty square, for pawns that can double jump
+    Bitboard capturesWest = 0;      // One square forward and one column down, onto an enemy piece
+    Bitboard capturesEast = 0;      // One square forward and one column up, onto an enemy piece
+    Bitboard promotions = 0;        // The pushes and captures that land on the pawns' last row
+};
 
 class Pawn : public ChessPiece {
     private:
@@ -40,6 +58,18 @@ class Pawn : public ChessPiece {
         */        
         Pawn(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false, const bool& double_jumpable = false);
 
+        /**
+         * @brief Unpacking constructor. Rebuilds a Pawn, including its double_jumpable_ flag, from its packed form.
+         * @param packed A const reference to the packed pawn
+         */
+        explicit Pawn(const PackedPiece& packed);
+
+        /**
+         * @brief Packs this pawn, including its double_jumpable_ flag, into a single 64-bit word
+         * @return The packed form of the pawn
+         */
+        PackedPiece pack() const;
+
         /**
          * @brief Gets the value of the flag for the Pawn can double jump
          * @return The boolean value stored in double_jumpable_
@@ -60,4 +90,32 @@ class Pawn : public ChessPiece {
          * @return True if this pawn can be promoted. False otherwise.
          */
         bool canPromote() const;
+
+        /**
+         * @brief Same rule as canPromote() above, evaluated directly on a packed pawn
+         * @param pawn A const reference to the packed pawn
+         * @return True if the pawn can be promoted. False otherwise.
+         */
+        static bool canPromote(const PackedPiece& pawn);
+
+        /**
+         * @brief Computes the moves of a whole set of pawns at once with shift-and-mask bitboard operations.
+         * @param pawns The squares of the pawns, all moving in the same direction
+         * @param doubleJumpable The squares of the pawns that can double jump (other squares are ignored)
+         * @param movingUp The direction the pawns move in (see ChessPiece::isMovingUp)
+         * @param empty The empty squares of the board
+         * @param enemies The squares occupied by pieces the pawns can capture
+         * @return The destinations of every push, double push, capture and promotion
+         */
+        static PawnMoves generate(Bitboard pawns, Bitboard doubleJumpable, bool movingUp, Bitboard empty, Bitboard enemies);
+
+        /**
+         * @brief Computes the moves of all of a player's pawns on the given board. Since every pawn has 
+         *     its own movingUp_ flag, the pawns moving up and those moving down are generated separately.
+         * @param board A const reference to the board
+         * @param player The index of the player whose pawns move (0 for P1, 1 for P2)
+         * @param up Set to the moves of the player's pawns moving up
+         * @param down Set to the moves of the player's pawns moving down
+         */
+        static void generate(const Board& board, int player, PawnMoves& up, PawnMoves& down);
 };
\ No newline at end of file
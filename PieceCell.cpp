@@ -0,0 +1,70 @@
+// File: PieceCell.cpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A source files that defines PieceCell
+
+#include "PieceCell.hpp"
+
+/**
+ * @brief Default constructor. Holds a default-initialized ChessPiece (type "NONE", size 0).
+ */
+PieceCell::PieceCell() : piece_{ChessPiece()} {}
+
+/**
+ * @brief Converting constructors. Each stores a copy of the given piece, keeping its exact type.
+ */
+PieceCell::PieceCell(const ChessPiece& piece) : piece_{std::in_place_type<ChessPiece>, piece} {}
+PieceCell::PieceCell(const Pawn& pawn) : piece_{std::in_place_type<Pawn>, pawn} {}
+PieceCell::PieceCell(const Rook& rook) : piece_{std::in_place_type<Rook>, rook} {}
+
+/**
+ * @brief Unpacking constructor. Rebuilds a Pawn or Rook (by the packed type ID) with its own state, or a ChessPiece otherwise.
+ * @param packed A const reference to a piece packed by pack()
+ */
+PieceCell::PieceCell(const PackedPiece& packed) : piece_{ChessPiece(packed)} {
+    switch (packed.getTypeId()) {
+        case PieceType::PAWN: piece_.emplace<Pawn>(packed); break;
+        case PieceType::ROOK: piece_.emplace<Rook>(packed); break;
+        default: break;
+    }
+}
+
+/**
+ * @return The stored piece, viewed as its ChessPiece base
+ */
+const ChessPiece& PieceCell::piece() const {
+    switch (piece_.index()) {
+        case 1: return *std::get_if<Pawn>(&piece_);
+        case 2: return *std::get_if<Rook>(&piece_);
+        default: return *std::get_if<ChessPiece>(&piece_);
+    }
+}
+
+ChessPiece& PieceCell::piece() {
+    switch (piece_.index()) {
+        case 1: return *std::get_if<Pawn>(&piece_);
+        case 2: return *std::get_if<Rook>(&piece_);
+        default: return *std::get_if<ChessPiece>(&piece_);
+    }
+}
+
+/**
+ * @return The type ID of the stored piece
+ */
+int PieceCell::getTypeId() const {
+    return piece().getTypeId();
+}
+
+/**
+ * @return The size of the stored piece
+ */
+int PieceCell::size() const {
+    return piece().size();
+}
+
+/**
+ * @return The stored piece packed into a single word, including any Pawn / Rook specific state
+ */
+PackedPiece PieceCell::pack() const {
+    return visit([](const auto& piece) { return piece.pack(); });
+}
@@ -0,0 +1,86 @@
+// File: PieceCell.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines PieceCell, an inline tagged cell holding a ChessPiece, Pawn or Rook
+
+#pragma once
+#include <variant>
+#include <utility>
+#include "ChessPiece.hpp"
+#include "Pawn.hpp"
+#include "Rook.hpp"
+
+/**
+ * @class PieceCell
+ * @brief Holds a ChessPiece, Pawn or Rook by value, in storage sized for the largest of them.
+ * 
+ * Storing a Pawn or Rook in an ArrayBox<ChessPiece> slices away double_jumpable_ / castle_moves_left_.
+ * An ArrayBox<PieceCell> keeps the whole piece, without a heap allocation per piece, 
+ * and visit() dispatches to the exact piece type through a switch on the tag instead of virtual calls.
+ * 
+ * It has the getTypeId() and size() members ArrayBox needs, so it can be used as the box's item type directly.
+ */
+class PieceCell {
+    private:
+        std::variant<ChessPiece, Pawn, Rook> piece_;
+
+    public:
+        /**
+         * @brief Default constructor. Holds a default-initialized ChessPiece (type "NONE", size 0).
+         */
+        PieceCell();
+
+        /**
+         * @brief Converting constructors. Each stores a copy of the given piece, keeping its exact type.
+         */
+        PieceCell(const ChessPiece& piece);
+        PieceCell(const Pawn& pawn);
+        PieceCell(const Rook& rook);
+
+        /**
+         * @brief Unpacking constructor. Rebuilds a Pawn or Rook (by the packed type ID) with its own state, or a ChessPiece otherwise.
+         * @param packed A const reference to a piece packed by pack()
+         */
+        explicit PieceCell(const PackedPiece& packed);
+
+        /**
+         * @return The stored piece, viewed as its ChessPiece base
+         */
+        const ChessPiece& piece() const;
+        ChessPiece& piece();
+
+        /**
+         * @return The type ID of the stored piece
+         */
+        int getTypeId() const;
+
+        /**
+         * @return The size of the stored piece
+         */
+        int size() const;
+
+        /**
+         * @return The stored piece packed into a single word, including any Pawn / Rook specific state
+         */
+        PackedPiece pack() const;
+
+        /**
+         * @return A pointer to the stored piece if it is exactly of type P (ChessPiece, Pawn or Rook), nullptr otherwise
+         */
+        template <typename P>
+        const P* get() const { return std::get_if<P>(&piece_); }
+
+        template <typename P>
+        P* get() { return std::get_if<P>(&piece_); }
+
+        /**
+         * @brief Calls the visitor with the stored piece as its exact type (const ChessPiece&, const Pawn& or const Rook&)
+         * @param visitor A callable accepting each of the three piece types, eg. a generic lambda
+         * @return Whatever the visitor returns
+         */
+        template <typename Visitor>
+        decltype(auto) visit(Visitor&& visitor) const { return std::visit(std::forward<Visitor>(visitor), piece_); }
+
+        template <typename Visitor>
+        decltype(auto) visit(Visitor&& visitor) { return std::visit(std::forward<Visitor>(visitor), piece_); }
+};
@@ -0,0 +1,404 @@
+// File: PositionArchive.cpp
+// Author: Tahfizur Rahman
+// Date: 10/16/2026
+// A source files that defines MaterialQuery, ArchiveWriter and PositionArchive
+
+#include "PositionArchive.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ScanKernels.hpp"
+
+static_assert(sizeof(PositionArchive::Header) == 32, "The header layout is part of the file format");
+static_assert(sizeof(PositionArchive::ColumnEntry) == 48, "The column entry layout is part of the file format");
+
+static const int RUNS_PER_WORKER = 8;   // Runs of blocks handed to each worker, so stealing can even out uneven runs
+
+/**
+ * @return The first multiple of 64 at or after offset
+ */
+static uint64_t alignColumn(uint64_t offset) {
+    return (offset + 63) / 64 * 64;
+}
+
+/**
+ * @brief Requires the number of pieces of the given color and type to be in [min, max]
+ * @return A reference to this query, so conditions can be chained
+ */
+MaterialQuery& MaterialQuery::count(const std::string& color, const std::string& type, int min, int max) {
+    conditions_.push_back(Condition{color, type, min, max, 0});
+    return *this;
+}
+
+/**
+ * @brief Requires a piece of the given color and type on every one of the given squares (see Board::squareBit)
+ * @return A reference to this query, so conditions can be chained
+ */
+MaterialQuery& MaterialQuery::occupies(const std::string& color, const std::string& type, Bitboard squares) {
+    conditions_.push_back(Condition{color, type, 0, 255, squares});
+    return *this;
+}
+
+/**
+ * @return The conditions, in the order they were added
+ */
+const std::vector<MaterialQuery::Condition>& MaterialQuery::conditions() const {
+    return conditions_;
+}
+
+ArchiveWriter::ArchiveWriter() : size_{0} {}
+
+/**
+ * @return The index in columns_ of the given pair, adding an all-empty column for it if it is new
+ */
+int ArchiveWriter::column(int colorId, int typeId) {
+    uint64_t key = (static_cast<uint64_t>(colorId) << 32) | static_cast<uint32_t>(typeId);
+    auto found = columnOf_.find(key);
+    if (found != columnOf_.end()) { return found->second; }
+
+    // Every position before this one had none of the pair
+    Column column;
+    column.color = NameRegistry::colors().nameOf(colorId);
+    column.type = NameRegistry::pieceTypes().nameOf(typeId);
+    column.counts.assign(size_, 0);
+    column.squares.assign(size_, 0);
+    columns_.push_back(std::move(column));
+    tally_.push_back(0);
+    board_.push_back(0);
+
+    int index = static_cast<int>(columns_.size()) - 1;
+    columnOf_[key] = index;
+    return index;
+}
+
+/**
+ * @brief Appends a position's counts and squares to every column
+ * @param box A const reference to the position
+ * @return True if the position was appended. False if it has more than 255 pieces of one color and type,
+ *      in which case nothing is appended.
+ */
+bool ArchiveWriter::append(const ChessBox& box) {
+    // Tally the position first, so one that does not fit leaves every column as it was
+    const PieceBox* boxes[] = {&box.viewP1Pieces(), &box.viewP2Pieces()};
+    touched_.clear();
+    for (int player = 0; player < Board::PLAYERS; player++) {
+        int colorId = box.getBoard().colorIdOf(player);
+        for (const PieceCell& cell : *boxes[player]) {
+            int index = column(colorId, cell.getTypeId());
+            if (tally_[index]++ == 0) { touched_.push_back(index); }
+
+            const ChessPiece& piece = cell.piece();
+            if (Board::onBoard(piece.getRow(), piece.getColumn())) { board_[index] |= Board::squareBit(piece.getRow(), piece.getColumn()); }
+        }
+    }
+
+    bool fits = std::all_of(touched_.begin(), touched_.end(), [this](int index) { return tally_[index] <= 255; });
+    if (fits) {
+        for (Column& column : columns_) {
+            column.counts.push_back(0);
+            column.squares.push_back(0);
+        }
+        for (int index : touched_) {
+            columns_[index].counts.back() = static_cast<uint8_t>(tally_[index]);
+            columns_[index].squares.back() = board_[index];
+        }
+        size_++;
+    }
+
+    for (int index : touched_) {
+        tally_[index] = 0;
+        board_[index] = 0;
+    }
+    return fits;
+}
+
+/**
+ * @return The number of positions appended
+ */
+uint64_t ArchiveWriter::size() const {
+    return size_;
+}
+
+/**
+ * @brief Writes the archive, replacing the file if it exists
+ * @param path A const reference to the path of the file to write
+ * @return True if the whole file was written. False if it could not be,
+ *      or a color or type name is too long for the archive (see PositionArchive::NAME_LENGTH).
+ */
+bool ArchiveWriter::write(const std::string& path) const {
+    PositionArchive::Header header = {};
+    std::memcpy(header.magic, PositionArchive::MAGIC, sizeof(PositionArchive::MAGIC));
+    header.version = PositionArchive::VERSION;
+    header.columnCount = static_cast<uint32_t>(columns_.size());
+    header.size = size_;
+
+    // Lay the columns out after the directory, each on its own 64-byte boundary
+    std::vector<PositionArchive::ColumnEntry> entries(columns_.size());
+    uint64_t offset = alignColumn(sizeof(header) + entries.size() * sizeof(PositionArchive::ColumnEntry));
+    for (std::size_t i = 0; i < columns_.size(); i++) {
+        const Column& column = columns_[i];
+        if (column.color.size() >= PositionArchive::NAME_LENGTH || column.type.size() >= PositionArchive::NAME_LENGTH) { return false; }
+
+        std::memset(&entries[i], 0, sizeof(PositionArchive::ColumnEntry));
+        std::memcpy(entries[i].color, column.color.data(), column.color.size());
+        std::memcpy(entries[i].type, column.type.data(), column.type.size());
+        entries[i].countsOffset = offset;
+        offset = alignColumn(offset + size_);
+        entries[i].squaresOffset = offset;
+        offset = alignColumn(offset + size_ * sizeof(Bitboard));
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) { return false; }
+
+    static const char padding[64] = {};
+    uint64_t written = 0;
+    auto put = [&](const void* data, uint64_t bytes) {
+        if (bytes > 0 && std::fwrite(data, 1, bytes, file) != bytes) { return false; }
+        written += bytes;
+        return true;
+    };
+    auto padTo = [&](uint64_t target) { return put(padding, target - written); };
+
+    bool ok = put(&header, sizeof(header)) && put(entries.data(), entries.size() * sizeof(PositionArchive::ColumnEntry));
+    for (std::size_t i = 0; ok && i < columns_.size(); i++) {
+        ok = padTo(entries[i].countsOffset) && put(columns_[i].counts.data(), size_)
+            && padTo(entries[i].squaresOffset) && put(columns_[i].squares.data(), size_ * sizeof(Bitboard));
+    }
+    return std::fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief Default constructor. No archive is open.
+ */
+PositionArchive::PositionArchive() : mapping_{nullptr}, length_{0}, size_{0} {}
+
+/**
+ * @brief Parameterized constructor. Same as calling open() on a default-constructed PositionArchive.
+ * @param path A const reference to the path of the archive. Check isOpen() to see if it worked.
+ */
+PositionArchive::PositionArchive(const std::string& path) : PositionArchive() {
+    open(path);
+}
+
+/**
+ * @brief Destructor
+ * @post Unmaps the archive
+ */
+PositionArchive::~PositionArchive() {
+    close();
+}
+
+/**
+ * @brief Maps the given archive, closing the one open before
+ * @param path A const reference to the path of the archive
+ * @return True if it was mapped. False if it can not be read, is not an archive of this version,
+ *      or a column lies outside the file.
+ */
+bool PositionArchive::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) { return false; }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    std::size_t length = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) { return false; }
+
+    const char* base = static_cast<const char*>(mapping);
+    const Header* header = reinterpret_cast<const Header*>(base);
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 && header->version == VERSION
+        && header->columnCount <= (length - sizeof(Header)) / sizeof(ColumnEntry) && header->size <= length;
+
+    const ColumnEntry* entries = reinterpret_cast<const ColumnEntry*>(base + sizeof(Header));
+    for (uint32_t i = 0; valid && i < header->columnCount; i++) {
+        const ColumnEntry& entry = entries[i];
+        valid = strnlen(entry.color, NAME_LENGTH) < NAME_LENGTH && strnlen(entry.type, NAME_LENGTH) < NAME_LENGTH
+            && entry.countsOffset <= length && header->size <= length - entry.countsOffset
+            && entry.squaresOffset % sizeof(Bitboard) == 0 && entry.squaresOffset <= length
+            && header->size <= (length - entry.squaresOffset) / sizeof(Bitboard);
+        if (valid) {
+            columns_.push_back(Column{std::string_view(entry.color), std::string_view(entry.type),
+                reinterpret_cast<const uint8_t*>(base + entry.countsOffset), reinterpret_cast<const Bitboard*>(base + entry.squaresOffset)});
+        }
+    }
+    if (!valid) {
+        columns_.clear();
+        munmap(mapping, length);
+        return false;
+    }
+
+    mapping_ = mapping;
+    length_ = length;
+    size_ = header->size;
+    return true;
+}
+
+/**
+ * @brief Unmaps the archive, if one is open
+ */
+void PositionArchive::close() {
+    if (mapping_ == nullptr) { return; }
+
+    munmap(mapping_, length_);
+    mapping_ = nullptr;
+    length_ = 0;
+    size_ = 0;
+    columns_.clear();
+}
+
+/**
+ * @return True if an archive is mapped
+ */
+bool PositionArchive::isOpen() const {
+    return mapping_ != nullptr;
+}
+
+/**
+ * @return The number of positions in the archive, or 0 if none is open
+ */
+uint64_t PositionArchive::size() const {
+    return size_;
+}
+
+/**
+ * @return The column of the given pair, or nullptr if no position has it
+ */
+const PositionArchive::Column* PositionArchive::column(std::string_view color, std::string_view type) const {
+    for (const Column& column : columns_) {
+        if (column.color == color && column.type == type) { return &column; }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Resolves each condition to the column it reads. A missing column holds only zeros.
+ */
+PositionArchive::Plan PositionArchive::plan(const MaterialQuery& query) const {
+    Plan plan;
+    for (const MaterialQuery::Condition& condition : query.conditions()) {
+        int low = std::max(condition.min, 0), high = std::min(condition.max, 255);
+        const Column* column = this->column(condition.color, condition.type);
+        if (low > high || (column == nullptr && (low > 0 || condition.squares != 0))) {
+            plan.impossible = true;
+            continue;
+        }
+        if (column == nullptr) { continue; }
+
+        // A range covering every count, or no squares, holds for every position, so it is not scanned
+        if (low > 0 || high < 255) { plan.ranges.push_back(Plan::Range{column->counts, static_cast<uint8_t>(low), static_cast<uint8_t>(high)}); }
+        if (condition.squares != 0) { plan.squares.push_back(Plan::Squares{column->squares, condition.squares}); }
+    }
+    return plan;
+}
+
+/**
+ * @brief Sets mask[i] to 0xFF if position begin + i matches the plan, and to 0 otherwise
+ */
+void PositionArchive::scan(const Plan& plan, uint64_t begin, int length, unsigned char* mask) {
+    std::memset(mask, 0xFF, length);
+    for (const Plan::Range& range : plan.ranges) {
+        ScanKernels::maskInRange(range.counts + begin, length, range.low, range.high, mask);
+    }
+    for (const Plan::Squares& squares : plan.squares) {
+        const Bitboard* boards = squares.squares + begin;
+        for (int i = 0; i < length; i++) {
+            if ((boards[i] & squares.mask) != squares.mask) { mask[i] = 0; }
+        }
+    }
+}
+
+/**
+ * @brief Splits [0, size_) into runs of whole blocks, one per task, and calls visit(task, begin, end) for each,
+ *      on the pool's workers if there is a pool and on the calling thread otherwise
+ * @return The number of tasks
+ */
+template <typename Visit>
+std::size_t PositionArchive::forEachRun(WorkStealingPool* pool, Visit&& visit) const {
+    uint64_t blocks = (size_ + BLOCK - 1) / BLOCK;
+    uint64_t runs = std::min<uint64_t>(blocks, pool != nullptr ? pool->size() * RUNS_PER_WORKER : 1);
+    if (runs == 0) { return 0; }
+    uint64_t runLength = (blocks + runs - 1) / runs * BLOCK;
+
+    std::vector<WorkStealingPool::Task> tasks;
+    std::size_t task = 0;
+    for (uint64_t begin = 0; begin < size_; begin += runLength, task++) {
+        uint64_t end = std::min(size_, begin + runLength);
+        if (pool == nullptr) {
+            visit(task, begin, end);
+        } else {
+            tasks.push_back([&visit, task, begin, end](int) { visit(task, begin, end); });
+        }
+    }
+    if (pool != nullptr) { pool->run(std::move(tasks)); }
+    return task;
+}
+
+/**
+ * @param query A const reference to the conditions to match
+ * @param pool The workers to scan on, or nullptr to scan on the calling thread. Default nullptr.
+ * @return The number of positions that meet every condition
+ */
+uint64_t PositionArchive::count(const MaterialQuery& query, WorkStealingPool* pool) const {
+    Plan plan = this->plan(query);
+    if (plan.impossible) { return 0; }
+
+    // One cache line per run, so workers adding to their own count do not slow each other down
+    struct alignas(64) Count { uint64_t matches = 0; };
+    std::vector<Count> counts(pool != nullptr ? pool->size() * RUNS_PER_WORKER : 1);
+    forEachRun(pool, [this, &plan, &counts](std::size_t run, uint64_t begin, uint64_t end) {
+        unsigned char mask[BLOCK];
+        for (uint64_t block = begin; block < end; block += BLOCK) {
+            int length = static_cast<int>(std::min<uint64_t>(BLOCK, end - block));
+            scan(plan, block, length, mask);
+            counts[run].matches += ScanKernels::count(mask, length, 0xFF);
+        }
+    });
+
+    uint64_t matches = 0;
+    for (const Count& count : counts) { matches += count.matches; }
+    return matches;
+}
+
+/**
+ * @param query A const reference to the conditions to match
+ * @param pool The workers to scan on, or nullptr to scan on the calling thread. Default nullptr.
+ * @return The numbers of the positions that meet every condition, in increasing order
+ */
+std::vector<uint64_t> PositionArchive::find(const MaterialQuery& query, WorkStealingPool* pool) const {
+    Plan plan = this->plan(query);
+    if (plan.impossible) { return {}; }
+
+    // Each run collects its own matches, and runs are in order, so joining them keeps the numbers increasing
+    std::vector<std::vector<uint64_t>> found(pool != nullptr ? pool->size() * RUNS_PER_WORKER : 1);
+    std::size_t runs = forEachRun(pool, [this, &plan, &found](std::size_t run, uint64_t begin, uint64_t end) {
+        unsigned char mask[BLOCK];
+        for (uint64_t block = begin; block < end; block += BLOCK) {
+            int length = static_cast<int>(std::min<uint64_t>(BLOCK, end - block));
+            scan(plan, block, length, mask);
+            for (int i = ScanKernels::find(mask, length, 0xFF); i != -1; ) {
+                found[run].push_back(block + i);
+                int next = ScanKernels::find(mask + i + 1, length - i - 1, 0xFF);
+                i = next == -1 ? -1 : i + 1 + next;
+            }
+        }
+    });
+
+    std::vector<uint64_t> matches;
+    for (std::size_t run = 0; run < runs; run++) {
+        matches.insert(matches.end(), found[run].begin(), found[run].end());
+    }
+    return matches;
+}
@@ -0,0 +1,248 @@
+// File: PositionArchive.hpp
+// Author: Tahfizur Rahman
+// Date: 10/16/2026
+// A header files that defines ArchiveWriter, PositionArchive and MaterialQuery, a columnar store of ChessBox positions
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ChessBox.hpp"
+#include "WorkStealingPool.hpp"
+
+/**
+ * An archive keeps no ChessBoxes, only two columns per (color, piece type) pair seen in any of its positions:
+ *  - counts:  one byte per position, the number of pieces of that color and type (on the board or not)
+ *  - squares: one Bitboard per position, the squares those pieces stand on
+ * Every column holds one entry per position, so position i is entry i of each column, and a pair a position
+ * does not have is stored as 0 / an empty Bitboard. Colors and types are stored by name, so an archive can be
+ * read by another process whatever IDs the registries handed out there.
+ *
+ * Counts are narrowed to a byte and squares to a 64-bit board, instead of being stored as lists of pieces,
+ * which keeps every column fixed-width so a query can start scanning anywhere and compare 16-32 counts at once.
+ *
+ * File layout: a 32-byte Header, then a ColumnEntry per pair, then the columns, each starting on a 64-byte boundary.
+ */
+
+/**
+ * @class MaterialQuery
+ * @brief The conditions a position must meet to match, all of which must hold, eg. for
+ *      "BLACK holds a ROOK and more than 4 PAWNs": MaterialQuery().count("BLACK", "ROOK", 1).count("BLACK", "PAWN", 5)
+ */
+class MaterialQuery {
+    public:
+        struct Condition {
+            std::string color, type;    // The pair of the column the condition reads
+            int min, max;               // The range the count must fall in
+            Bitboard squares;           // The squares that must all hold such a piece
+        };
+
+    private:
+        std::vector<Condition> conditions_;
+
+    public:
+        /**
+         * @brief Requires the number of pieces of the given color and type to be in [min, max]
+         * @return A reference to this query, so conditions can be chained
+         */
+        MaterialQuery& count(const std::string& color, const std::string& type, int min, int max = 255);
+
+        /**
+         * @brief Requires a piece of the given color and type on every one of the given squares (see Board::squareBit)
+         * @return A reference to this query, so conditions can be chained
+         */
+        MaterialQuery& occupies(const std::string& color, const std::string& type, Bitboard squares);
+
+        /**
+         * @return The conditions, in the order they were added
+         */
+        const std::vector<Condition>& conditions() const;
+};
+
+/**
+ * @class ArchiveWriter
+ * @brief Collects the columns of a sequence of positions in memory, and writes them out as an archive.
+ *      Positions are numbered in the order they are appended, from 0.
+ */
+class ArchiveWriter {
+    private:
+        struct Column {
+            std::string color, type;
+            std::vector<uint8_t> counts;
+            std::vector<Bitboard> squares;
+        };
+
+        std::vector<Column> columns_;
+        std::unordered_map<uint64_t, int> columnOf_;   // The index in columns_ of each (color ID, type ID) pair
+        uint64_t size_;                                // The number of positions appended
+
+        std::vector<int> tally_;          // Scratch space for append(): the count of each column in the position
+        std::vector<Bitboard> board_;     // Scratch space for append(): the squares of each column in the position
+        std::vector<int> touched_;        // Scratch space for append(): the columns the position has pieces in
+
+        /**
+         * @return The index in columns_ of the given pair, adding an all-empty column for it if it is new
+         */
+        int column(int colorId, int typeId);
+
+    public:
+        ArchiveWriter();
+
+        /**
+         * @brief Appends a position's counts and squares to every column
+         * @param box A const reference to the position
+         * @return True if the position was appended. False if it has more than 255 pieces of one color and type,
+         *      in which case nothing is appended.
+         */
+        bool append(const ChessBox& box);
+
+        /**
+         * @return The number of positions appended
+         */
+        uint64_t size() const;
+
+        /**
+         * @brief Writes the archive, replacing the file if it exists
+         * @param path A const reference to the path of the file to write
+         * @return True if the whole file was written. False if it could not be, 
+         *      or a color or type name is too long for the archive (see PositionArchive::NAME_LENGTH).
+         */
+        bool write(const std::string& path) const;
+};
+
+/**
+ * @class PositionArchive
+ * @brief A read-only, memory-mapped archive written by ArchiveWriter, and the engine that queries it.
+ *      A query scans only the columns its conditions read, block by block: each condition clears the entries of a
+ *      per-block mask that fail it (counts with ScanKernels::maskInRange), and the entries left are counted or collected.
+ *      Given a pool, the blocks are split into tasks spread over its workers.
+ */
+class PositionArchive {
+    public:
+        static constexpr char MAGIC[8] = {'C', 'H', 'E', 'S', 'S', 'A', 'R', 'C'};
+        static const uint32_t VERSION = 1;     // Bumped whenever the layout changes
+        static const int NAME_LENGTH = 16;     // The longest color or type name that fits, plus its terminating '\0'
+        static const int BLOCK = 4096;         // The positions each mask covers
+
+        struct Header {
+            char magic[8];            // MAGIC
+            uint32_t version;         // VERSION
+            uint32_t columnCount;     // The number of ColumnEntries after the header
+            uint64_t size;            // The number of positions
+            uint64_t reserved;        // 0
+        };
+
+        struct ColumnEntry {
+            char color[NAME_LENGTH];  // '\0'-padded
+            char type[NAME_LENGTH];   // '\0'-padded
+            uint64_t countsOffset;    // Where the counts column starts, from the start of the file
+            uint64_t squaresOffset;   // Where the squares column starts, from the start of the file
+        };
+
+    private:
+        struct Column {
+            std::string_view color, type;
+            const uint8_t* counts;
+            const Bitboard* squares;
+        };
+
+        /**
+         * @brief A query resolved against the columns: the count ranges and square masks to apply to each block
+         */
+        struct Plan {
+            struct Range { const uint8_t* counts; uint8_t low, high; };
+            struct Squares { const Bitboard* squares; Bitboard mask; };
+            std::vector<Range> ranges;
+            std::vector<Squares> squares;
+            bool impossible = false;    // Whether some condition can not hold for any position
+        };
+
+        void* mapping_;             // The start of the mapped file, or nullptr if no archive is open
+        std::size_t length_;        // The length of the mapping in bytes
+        uint64_t size_;             // The number of positions
+        std::vector<Column> columns_;
+
+        /**
+         * @return The column of the given pair, or nullptr if no position has it
+         */
+        const Column* column(std::string_view color, std::string_view type) const;
+
+        /**
+         * @brief Resolves each condition to the column it reads. A missing column holds only zeros.
+         */
+        Plan plan(const MaterialQuery& query) const;
+
+        /**
+         * @brief Sets mask[i] to 0xFF if position begin + i matches the plan, and to 0 otherwise
+         */
+        static void scan(const Plan& plan, uint64_t begin, int length, unsigned char* mask);
+
+        /**
+         * @brief Splits [0, size_) into runs of whole blocks, one per task, and calls visit(task, begin, end) for each,
+         *      on the pool's workers if there is a pool and on the calling thread otherwise
+         * @return The number of tasks
+         */
+        template <typename Visit>
+        std::size_t forEachRun(WorkStealingPool* pool, Visit&& visit) const;
+
+    public:
+        /**
+         * @brief Default constructor. No archive is open.
+         */
+        PositionArchive();
+
+        /**
+         * @brief Parameterized constructor. Same as calling open() on a default-constructed PositionArchive.
+         * @param path A const reference to the path of the archive. Check isOpen() to see if it worked.
+         */
+        explicit PositionArchive(const std::string& path);
+
+        PositionArchive(const PositionArchive&) = delete;
+        PositionArchive& operator=(const PositionArchive&) = delete;
+
+        /**
+         * @brief Destructor
+         * @post Unmaps the archive
+         */
+        ~PositionArchive();
+
+        /**
+         * @brief Maps the given archive, closing the one open before
+         * @param path A const reference to the path of the archive
+         * @return True if it was mapped. False if it can not be read, is not an archive of this version,
+         *      or a column lies outside the file.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Unmaps the archive, if one is open
+         */
+        void close();
+
+        /**
+         * @return True if an archive is mapped
+         */
+        bool isOpen() const;
+
+        /**
+         * @return The number of positions in the archive, or 0 if none is open
+         */
+        uint64_t size() const;
+
+        /**
+         * @param query A const reference to the conditions to match
+         * @param pool The workers to scan on, or nullptr to scan on the calling thread. Default nullptr.
+         * @return The number of positions that meet every condition
+         */
+        uint64_t count(const MaterialQuery& query, WorkStealingPool* pool = nullptr) const;
+
+        /**
+         * @param query A const reference to the conditions to match
+         * @param pool The workers to scan on, or nullptr to scan on the calling thread. Default nullptr.
+         * @return The numbers of the positions that meet every condition, in increasing order
+         */
+        std::vector<uint64_t> find(const MaterialQuery& query, WorkStealingPool* pool = nullptr) const;
+};
@@ -4,6 +4,22 @@
 // Date: 03/04/2025
 // A source files that defines Rook class
 #include "Rook.hpp"
+#include "RookMagics.hpp"
+
+#include <utility>
+
+// All built by the compiler, see RookMagics.hpp
+static constexpr std::array<RookMagics::Entry, Board::SQUARES> ROOK_MAGICS = RookMagics::buildEntries();
+
+template <int SQUARE>
+static constexpr auto ROOK_SLICE = RookMagics::buildSlice<SQUARE>();
+
+template <int... SQUARES>
+static constexpr std::array<const Bitboard*, Board::SQUARES> rookSlices(std::integer_sequence<int, SQUARES...>) {
+    return {{ ROOK_SLICE<SQUARES>.data()... }};
+}
+
+static constexpr std::array<const Bitboard*, Board::SQUARES> ROOK_ATTACKS = rookSlices(std::make_integer_sequence<int, Board::SQUARES>{});
 
 /**
  * @brief Default Constructor. By default, Rooks have 3 available castle moves to make
@@ -13,7 +29,7 @@
 */
 Rook::Rook() : ChessPiece(), castle_moves_left_{3} {
     setSize(2);
-    setType("ROOK");
+    setTypeId(PieceType::ROOK);
 }
 
 /**
@@ -31,7 +47,23 @@ Rook::Rook() : ChessPiece(), castle_moves_left_{3} {
 * 2) The type member is set to "ROOK"   
 */
 Rook::Rook(const std::string& color, const int& row, const int& col, const bool& movingUp, const int& castle_moves_capacity) :
-    ChessPiece(color, row, col, movingUp, 2, "ROOK"), castle_moves_left_{ std::max(0, castle_moves_capacity) } {}
+    ChessPiece(color, row, col, movingUp, 2, PieceType::ROOK), castle_moves_left_{ std::max(0, castle_moves_capacity) } {}
+
+/**
+ * @brief Unpacking constructor. Rebuilds a Rook, including its castle_moves_left_, from its packed form.
+ * @param packed A const reference to the packed rook
+ */
+Rook::Rook(const PackedPiece& packed) : ChessPiece(packed), castle_moves_left_{packed.getCastleMovesLeft()} {}
+
+/**
+ * @brief Packs this rook, including its castle_moves_left_, into a single 64-bit word
+ * @return The packed form of the rook
+ */
+PackedPiece Rook::pack() const {
+    PackedPiece packed = ChessPiece::pack();
+    packed.setCastleMovesLeft(castle_moves_left_);
+    return packed;
+}
 
 /**
  * @brief Gets the value of the castle_moves_left_
@@ -41,6 +73,25 @@ int Rook::getCastleMovesLeft() const {
     return castle_moves_left_;
 }
 
+/**
+ * @brief Uses up one of the rook's castle moves, eg. once it has castled
+ * @return True if a castle move was available and has been used. False if there were none left.
+ * @post castle_moves_left_ is decremented if it was positive
+ */
+bool Rook::consumeCastleMove() {
+    if (castle_moves_left_ <= 0) { return false; }
+    castle_moves_left_--;
+    return true;
+}
+
+/**
+ * @brief Gives back a castle move used by consumeCastleMove(), eg. when a castle is undone
+ * @post castle_moves_left_ is incremented
+ */
+void Rook::refundCastleMove() {
+    castle_moves_left_++;
+}
+
 /**
  * @brief Determines if this rook can castle with the parameter Chess Piece
  *     This rook can castle with another piece if:
@@ -61,4 +112,61 @@ bool Rook::canCastle(const ChessPiece& target) const {
     if (getRow() != target.getRow() || std::abs(getColumn() - target.getColumn()) > 1) { return false; }
 
     return true;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Same rule as canCastle() above, evaluated directly on packed pieces. 
+ *     Colors are compared by their NameRegistry::colors() ID.
+ * @param rook A const reference to the packed rook
+ * @param target A const reference to the packed piece the rook may / may not be able to castle with
+ * @return True if the rook can castle with the given piece. False otherwise.
+ */
+bool Rook::canCastle(const PackedPiece& rook, const PackedPiece& target) {
+    // Ensure there are castle moves available & the pieces share color
+    if (rook.getCastleMovesLeft() == 0 || rook.getColorId() != target.getColorId()) { return false; }
+
+    // Ensure both pieces are on the board
+    if (!rook.isOnBoard() || !target.isOnBoard()) { return false; }
+
+    // Ensure they are in the same row or columns differ by at most 1 next to each other
+    if (rook.getRow() != target.getRow() || std::abs(rook.getColumn() - target.getColumn()) > 1) { return false; }
+
+    return true;
+}
+
+/**
+ * @brief Looks up the squares a rook on the given square attacks, using the compile-time magic-bitboard tables.
+ *     A rook attacks every square along its row and column up to and including the first occupied square in each direction.
+ * @param square The bit index (see Board::square) of the rook's square
+ * @param occupancy Every occupied square on the board (eg. Board::occupied())
+ * @return The attacked squares as a bitboard
+ */
+Bitboard Rook::attacks(int square, Bitboard occupancy) {
+    const RookMagics::Entry& entry = ROOK_MAGICS[square];
+    return ROOK_ATTACKS[square][((occupancy & entry.mask) * entry.magic) >> entry.shift];
+}
+
+/**
+ * @brief Gets the squares this rook can slide to on the given board: 
+ *     its attacks, minus the squares occupied by pieces of its own color
+ * @param board A const reference to the board this rook stands on
+ * @return The destination squares as a bitboard. Empty if the rook is not on the board, 
+ *     or its color does not belong to either of the board's players.
+ */
+Bitboard Rook::moves(const Board& board) const {
+    int player = board.playerOf(NameRegistry::colors().find(getColor()));
+    if (player == -1 || getRow() < 0 || getColumn() < 0) { return 0; }
+    return attacks(Board::square(getRow(), getColumn()), board.occupied()) & ~board.occupiedBy(player);
+}
+
+/**
+ * @brief Same as moves() above, evaluated directly on a packed rook
+ * @param rook A const reference to the packed rook
+ * @param board A const reference to the board the rook stands on
+ * @return The destination squares as a bitboard
+ */
+Bitboard Rook::moves(const PackedPiece& rook, const Board& board) {
+    int player = board.playerOf(rook.getColorId());
+    if (player == -1 || !rook.isOnBoard()) { return 0; }
+    return attacks(Board::square(rook.getRow(), rook.getColumn()), board.occupied()) & ~board.occupiedBy(player);
+}
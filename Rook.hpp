@@ -9,6 +9,8 @@
 #include <iostream>
 #include <algorithm>
 #include "ChessPiece.hpp"
+#include "PackedPiece.hpp"
+#include "Board.hpp"
 
 class Rook : public ChessPiece {
     private: 
@@ -41,6 +43,18 @@ class Rook : public ChessPiece {
         */
         Rook(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false, const int& castle_move_capacity = 3);
 
+        /**
+         * @brief Unpacking constructor. Rebuilds a Rook, including its castle_moves_left_, from its packed form.
+         * @param packed A const reference to the packed rook
+         */
+        explicit Rook(const PackedPiece& packed);
+
+        /**
+         * @brief Packs this rook, including its castle_moves_left_, into a single 64-bit word
+         * @return The packed form of the rook
+         */
+        PackedPiece pack() const;
+
     
        /**
          * @brief Determines if this rook can castle with the parameter Chess Piece
@@ -52,11 +66,59 @@ class Rook : public ChessPiece {
          * @return True if the rook can castle with the given piece. False otherwise.
          */
         bool canCastle(const ChessPiece& target) const;
+
+        /**
+         * @brief Same rule as canCastle() above, evaluated directly on packed pieces. 
+         *     Colors are compared by their NameRegistry::colors() ID.
+         * @param rook A const reference to the packed rook
+         * @param target A const reference to the packed piece the rook may / may not be able to castle with
+         * @return True if the rook can castle with the given piece. False otherwise.
+         */
+        static bool canCastle(const PackedPiece& rook, const PackedPiece& target);
         
 
+        /**
+         * @brief Looks up the squares a rook on the given square attacks, using the compile-time magic-bitboard tables.
+         *     A rook attacks every square along its row and column up to and including the first occupied square in each direction.
+         * @param square The bit index (see Board::square) of the rook's square
+         * @param occupancy Every occupied square on the board (eg. Board::occupied())
+         * @return The attacked squares as a bitboard
+         */
+        static Bitboard attacks(int square, Bitboard occupancy);
+
+        /**
+         * @brief Gets the squares this rook can slide to on the given board: 
+         *     its attacks, minus the squares occupied by pieces of its own color
+         * @param board A const reference to the board this rook stands on
+         * @return The destination squares as a bitboard. Empty if the rook is not on the board, 
+         *     or its color does not belong to either of the board's players.
+         */
+        Bitboard moves(const Board& board) const;
+
+        /**
+         * @brief Same as moves() above, evaluated directly on a packed rook
+         * @param rook A const reference to the packed rook
+         * @param board A const reference to the board the rook stands on
+         * @return The destination squares as a bitboard
+         */
+        static Bitboard moves(const PackedPiece& rook, const Board& board);
+
         /**
          * @brief Gets the value of the castle_moves_left_
          * @return The integer value stored in castle_moves_left_
          */
         int getCastleMovesLeft() const;
+
+        /**
+         * @brief Uses up one of the rook's castle moves, eg. once it has castled
+         * @return True if a castle move was available and has been used. False if there were none left.
+         * @post castle_moves_left_ is decremented if it was positive
+         */
+        bool consumeCastleMove();
+
+        /**
+         * @brief Gives back a castle move used by consumeCastleMove(), eg. when a castle is undone
+         * @post castle_moves_left_ is incremented
+         */
+        void refundCastleMove();
 };
\ No newline at end of file
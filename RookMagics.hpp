@@ -0,0 +1,175 @@
+// File: RookMagics.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines the magic-bitboard attack tables used by Rook
+
+#pragma once
+#include <array>
+#include "Board.hpp"
+
+/**
+ * @struct RookMagics
+ * @brief Everything needed to look up rook attacks with "fancy" magic bitboards.
+ * 
+ * For each square, only the blockers on the rook's relevant rays (mask, excluding the board's edge) matter.
+ * Multiplying those blockers by the square's magic number and keeping the top bits 
+ * gives a collision-free index into that square's attack table:
+ *      ATTACKS[square][((occupancy & mask) * magic) >> shift]
+ * 
+ * The magic numbers were found offline by random search. The masks and the 
+ * attack tables themselves are all built by constexpr functions, so they are computed by the compiler
+ * and cost nothing at startup. Only Rook.cpp should instantiate the tables.
+ */
+struct RookMagics {
+    struct Entry {
+        Bitboard mask;     // The relevant blocker squares for this square
+        Bitboard magic;    // The magic multiplier for this square
+        int shift;         // 64 - number of bits in mask
+    };
+
+    static constexpr Bitboard MAGICS[Board::SQUARES] = {
+        0x1080004008801020ULL, 0x0840092002C03000ULL, 0x1900200010400900ULL, 0x0880100008000480ULL,
+        0x4200100420080200ULL, 0x8100020100080400ULL, 0x0200040110886200ULL, 0x0200008040220411ULL,
+        0x0404800084400220ULL, 0x0000401000402000ULL, 0x0086001081220440ULL, 0x0408800800100280ULL,
+        0x000A001201040820ULL, 0x8848800200840080ULL, 0x4001000100040200ULL, 0x0442000102105084ULL,
+        0x9080010020804100ULL, 0x0040404000201009ULL, 0x0000808010002009ULL, 0x2200090021D00100ULL,
+        0x0008008008040080ULL, 0x0004004002010040ULL, 0x0011040008015042ULL, 0x00000A0001768104ULL,
+        0x0000800080204009ULL, 0x2010004140002001ULL, 0x9800200280100080ULL, 0x1000100080080080ULL,
+        0x0442000A00049020ULL, 0x2100040080020080ULL, 0x0800120400900148ULL, 0x0010040A00128541ULL,
+        0x2800804000800030ULL, 0x1010002000400041ULL, 0x4000200011004100ULL, 0x0610008410800800ULL,
+        0x0400802402800800ULL, 0xC100020080800400ULL, 0x0002000802000401ULL, 0x0182085882000401ULL,
+        0x0220204000808000ULL, 0x2860100040024022ULL, 0x0001002004110040ULL, 0x99101042000A0020ULL,
+        0x0004080004008080ULL, 0x0010040002008080ULL, 0x2012004881020004ULL, 0x8300842444820011ULL,
+        0x0088403882010200ULL, 0x0820400080210100ULL, 0x0110910040A00300ULL, 0x0801100280080480ULL,
+        0x0242009008200600ULL, 0x1002000489500200ULL, 0x0040800200010080ULL, 0x0091800041000080ULL,
+        0x0000209300488001ULL, 0x04C1002414824001ULL, 0x020020000B001041ULL, 0x7000100004200901ULL,
+        0x8002002004100802ULL, 0x30010002084C0007ULL, 0x0888221800813004ULL, 0x4000002840840112ULL
+    };
+
+    static constexpr int NORTH = 0, SOUTH = 1, EAST = 2, WEST = 3;   // Increasing row, decreasing row, increasing column, decreasing column
+
+    /**
+     * @return The squares a rook on `square` attacks, found by walking each ray until it hits a blocker (inclusive)
+     */
+    static constexpr Bitboard slowAttacks(int square, Bitboard occupancy) {
+        const int rowStep[4] = {1, -1, 0, 0};
+        const int colStep[4] = {0, 0, 1, -1};
+        Bitboard attacks = 0;
+        for (int dir = 0; dir < 4; dir++) {
+            int row = square / ChessPiece::BOARD_LENGTH + rowStep[dir];
+            int col = square % ChessPiece::BOARD_LENGTH + colStep[dir];
+            while (row >= 0 && row < ChessPiece::BOARD_LENGTH && col >= 0 && col < ChessPiece::BOARD_LENGTH) {
+                Bitboard bit = Bitboard{1} << (row * ChessPiece::BOARD_LENGTH + col);
+                attacks |= bit;
+                if (occupancy & bit) { break; }
+                row += rowStep[dir];
+                col += colStep[dir];
+            }
+        }
+        return attacks;
+    }
+
+    /**
+     * @return rays[dir][square], the empty-board ray from `square` in each direction
+     */
+    static constexpr std::array<std::array<Bitboard, Board::SQUARES>, 4> buildRays() {
+        std::array<std::array<Bitboard, Board::SQUARES>, 4> rays{};
+        for (int square = 0; square < Board::SQUARES; square++) {
+            Bitboard all = slowAttacks(square, 0);
+            int row = square / ChessPiece::BOARD_LENGTH;
+            int col = square % ChessPiece::BOARD_LENGTH;
+            for (int other = 0; other < Board::SQUARES; other++) {
+                Bitboard bit = Bitboard{1} << other;
+                if ((all & bit) == 0) { continue; }
+                int otherRow = other / ChessPiece::BOARD_LENGTH;
+                int otherCol = other % ChessPiece::BOARD_LENGTH;
+                int dir = otherRow > row ? NORTH : (otherRow < row ? SOUTH : (otherCol > col ? EAST : WEST));
+                rays[dir][square] |= bit;
+            }
+        }
+        return rays;
+    }
+
+    /**
+     * @return The index of the highest set bit of a non-empty bitboard
+     */
+    static constexpr int highestBit(Bitboard bits) {
+        int index = 0;
+        for (int half = 32; half > 0; half /= 2) {
+            if (bits >> half) { bits >>= half; index += half; }
+        }
+        return index;
+    }
+
+    /**
+     * @return Same as slowAttacks, but in a constant number of steps per direction: 
+     *         each ray is cut off behind its nearest blocker by removing the blocker's own ray.
+     *         This keeps building the whole table within the compiler's constexpr budget.
+     */
+    static constexpr Bitboard rayAttacks(const std::array<std::array<Bitboard, Board::SQUARES>, 4>& rays, int square, Bitboard occupancy) {
+        Bitboard attacks = 0;
+        for (int dir = 0; dir < 4; dir++) {
+            Bitboard ray = rays[dir][square];
+            Bitboard blockers = ray & occupancy;
+            if (blockers) {
+                // Squares grow along NORTH and EAST, so their nearest blocker is the lowest bit, otherwise the highest
+                int nearest = (dir == NORTH || dir == EAST) ? highestBit(blockers & (~blockers + 1)) : highestBit(blockers);
+                ray ^= rays[dir][nearest];
+            }
+            attacks |= ray;
+        }
+        return attacks;
+    }
+
+    /**
+     * @return The relevant blocker squares for a rook on `square`: its rays, minus the last square of each ray
+     */
+    static constexpr Bitboard relevantMask(int square) {
+        int row = square / ChessPiece::BOARD_LENGTH;
+        int col = square % ChessPiece::BOARD_LENGTH;
+        Bitboard mask = 0;
+        for (int r = row + 1; r < ChessPiece::BOARD_LENGTH - 1; r++) { mask |= Bitboard{1} << (r * ChessPiece::BOARD_LENGTH + col); }
+        for (int r = row - 1; r > 0; r--) { mask |= Bitboard{1} << (r * ChessPiece::BOARD_LENGTH + col); }
+        for (int c = col + 1; c < ChessPiece::BOARD_LENGTH - 1; c++) { mask |= Bitboard{1} << (row * ChessPiece::BOARD_LENGTH + c); }
+        for (int c = col - 1; c > 0; c--) { mask |= Bitboard{1} << (row * ChessPiece::BOARD_LENGTH + c); }
+        return mask;
+    }
+
+    static constexpr int popcount(Bitboard bits) {
+        int total = 0;
+        for (; bits; bits &= bits - 1) { total++; }
+        return total;
+    }
+
+    /**
+     * @return The mask, magic and shift of every square
+     */
+    static constexpr std::array<Entry, Board::SQUARES> buildEntries() {
+        std::array<Entry, Board::SQUARES> entries{};
+        for (int square = 0; square < Board::SQUARES; square++) {
+            Bitboard mask = relevantMask(square);
+            entries[square] = Entry{mask, MAGICS[square], 64 - popcount(mask)};
+        }
+        return entries;
+    }
+
+    /**
+     * @brief Fills one square's attack table by enumerating each subset of its mask 
+     *        (the "carry-rippler" trick) and storing the attacks at its magic index.
+     *        Every square is built in its own constant evaluation, which keeps each one 
+     *        well within the compiler's constexpr budget.
+     */
+    template <int SQUARE>
+    static constexpr std::array<Bitboard, (1 << popcount(relevantMask(SQUARE)))> buildSlice() {
+        std::array<Bitboard, (1 << popcount(relevantMask(SQUARE)))> slice{};
+        std::array<std::array<Bitboard, Board::SQUARES>, 4> rays = buildRays();
+        Bitboard mask = relevantMask(SQUARE);
+        int shift = 64 - popcount(mask);
+        Bitboard subset = 0;
+        do {
+            slice[static_cast<int>((subset * MAGICS[SQUARE]) >> shift)] = rayAttacks(rays, SQUARE, subset);
+            subset = (subset - mask) & mask;
+        } while (subset != 0);
+        return slice;
+    }
+};
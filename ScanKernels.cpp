@@ -0,0 +1,209 @@
+// File: ScanKernels.cpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A source files that defines ScanKernels
+
+#include "ScanKernels.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SCAN_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+static int findScalar(const unsigned char* data, int length, unsigned char value) {
+    for (int i = 0; i < length; i++) {
+        if (data[i] == value) { return i; }
+    }
+    return -1;
+}
+
+static int countScalar(const unsigned char* data, int length, unsigned char value) {
+    int total = 0;
+    for (int i = 0; i < length; i++) {
+        total += data[i] == value;
+    }
+    return total;
+}
+
+static void maskInRangeScalar(const unsigned char* data, int length, unsigned char low, unsigned char high, unsigned char* mask) {
+    for (int i = 0; i < length; i++) {
+        if (data[i] < low || data[i] > high) { mask[i] = 0; }
+    }
+}
+
+#ifdef SCAN_KERNELS_X86
+__attribute__((target("sse2")))
+static int findSse2(const unsigned char* data, int length, unsigned char value) {
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+    int i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask) { return i + __builtin_ctz(mask); }
+    }
+    int rest = findScalar(data + i, length - i, value);
+    return rest == -1 ? -1 : i + rest;
+}
+
+__attribute__((target("sse2,popcnt")))
+static int countSse2(const unsigned char* data, int length, unsigned char value) {
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+    int total = 0;
+    int i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        total += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+    }
+    return total + countScalar(data + i, length - i, value);
+}
+
+// SSE2 has no unsigned byte compare, but x is in [low, high] exactly when clamping it to the range leaves it unchanged
+__attribute__((target("sse2")))
+static void maskInRangeSse2(const unsigned char* data, int length, unsigned char low, unsigned char high, unsigned char* mask) {
+    const __m128i lows = _mm_set1_epi8(static_cast<char>(low));
+    const __m128i highs = _mm_set1_epi8(static_cast<char>(high));
+    int i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i inside = _mm_cmpeq_epi8(_mm_min_epu8(_mm_max_epu8(block, lows), highs), block);
+        __m128i* out = reinterpret_cast<__m128i*>(mask + i);
+        _mm_storeu_si128(out, _mm_and_si128(_mm_loadu_si128(out), inside));
+    }
+    maskInRangeScalar(data + i, length - i, low, high, mask + i);
+}
+
+// The AVX2 kernels finish their tails themselves rather than calling the SSE2 ones: those are compiled without VEX encoding,
+// and running legacy SSE instructions while the upper halves of the ymm registers are dirty costs far more than the scan itself.
+// The 16-byte steps below are VEX-encoded since they are compiled for AVX2 too.
+
+__attribute__((target("avx2")))
+static int findAvx2(const unsigned char* data, int length, unsigned char value) {
+    const __m256i needle = _mm256_set1_epi8(static_cast<char>(value));
+    int i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+        if (mask) { return i + __builtin_ctz(mask); }
+    }
+    if (i + 16 <= length) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm256_castsi256_si128(needle)));
+        if (mask) { return i + __builtin_ctz(mask); }
+        i += 16;
+    }
+    for (; i < length; i++) {
+        if (data[i] == value) { return i; }
+    }
+    return -1;
+}
+
+__attribute__((target("avx2,popcnt")))
+static int countAvx2(const unsigned char* data, int length, unsigned char value) {
+    const __m256i needle = _mm256_set1_epi8(static_cast<char>(value));
+    int total = 0;
+    int i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        total += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle))));
+    }
+    if (i + 16 <= length) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        total += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(block, _mm256_castsi256_si128(needle))));
+        i += 16;
+    }
+    for (; i < length; i++) {
+        total += data[i] == value;
+    }
+    return total;
+}
+
+__attribute__((target("avx2")))
+static void maskInRangeAvx2(const unsigned char* data, int length, unsigned char low, unsigned char high, unsigned char* mask) {
+    const __m256i lows = _mm256_set1_epi8(static_cast<char>(low));
+    const __m256i highs = _mm256_set1_epi8(static_cast<char>(high));
+    int i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i inside = _mm256_cmpeq_epi8(_mm256_min_epu8(_mm256_max_epu8(block, lows), highs), block);
+        __m256i* out = reinterpret_cast<__m256i*>(mask + i);
+        _mm256_storeu_si256(out, _mm256_and_si256(_mm256_loadu_si256(out), inside));
+    }
+    if (i + 16 <= length) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i inside = _mm_cmpeq_epi8(_mm_min_epu8(_mm_max_epu8(block, _mm256_castsi256_si128(lows)), _mm256_castsi256_si128(highs)), block);
+        __m128i* out = reinterpret_cast<__m128i*>(mask + i);
+        _mm_storeu_si128(out, _mm_and_si128(_mm_loadu_si128(out), inside));
+        i += 16;
+    }
+    for (; i < length; i++) {
+        if (data[i] < low || data[i] > high) { mask[i] = 0; }
+    }
+}
+#endif
+
+/**
+ * @brief The kernels picked for this CPU, resolved once on first use
+ */
+struct KernelTable {
+    int (*find)(const unsigned char*, int, unsigned char);
+    int (*count)(const unsigned char*, int, unsigned char);
+    void (*maskInRange)(const unsigned char*, int, unsigned char, unsigned char, unsigned char*);
+    const char* name;
+};
+
+static const KernelTable& kernels() {
+    static const KernelTable table = []() {
+#ifdef SCAN_KERNELS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) { return KernelTable{findAvx2, countAvx2, maskInRangeAvx2, "avx2"}; }
+        if (__builtin_cpu_supports("sse2") && __builtin_cpu_supports("popcnt")) { return KernelTable{findSse2, countSse2, maskInRangeSse2, "sse2"}; }
+#endif
+        return KernelTable{findScalar, countScalar, maskInRangeScalar, "scalar"};
+    }();
+    return table;
+}
+
+/**
+ * @param data The bytes to search
+ * @param length The number of bytes to search
+ * @param value The byte to search for
+ * @return The index of the first byte equal to value, or -1 if there is none
+ */
+int ScanKernels::find(const unsigned char* data, int length, unsigned char value) {
+    return kernels().find(data, length, value);
+}
+
+/**
+ * @param data The bytes to search
+ * @param length The number of bytes to search
+ * @param value The byte to count
+ * @return The number of bytes equal to value
+ */
+int ScanKernels::count(const unsigned char* data, int length, unsigned char value) {
+    return kernels().count(data, length, value);
+}
+
+/**
+ * @brief Clears every byte of mask whose byte in data is outside [low, high], leaving the others as they were.
+ *      Applying it once per condition to a mask that starts as all 0xFF leaves 0xFF exactly where every condition holds.
+ * @param data The bytes to test
+ * @param length The number of bytes to test
+ * @param low, high The range of values that keep their mask byte. If low > high, every byte of mask is cleared.
+ * @param mask The bytes to clear, parallel to data
+ */
+void ScanKernels::maskInRange(const unsigned char* data, int length, unsigned char low, unsigned char high, unsigned char* mask) {
+    // The kernels clamp to the range, which would keep the bytes equal to high, so an empty range is handled here
+    if (low > high) {
+        std::memset(mask, 0, length > 0 ? length : 0);
+        return;
+    }
+    kernels().maskInRange(data, length, low, high, mask);
+}
+
+/**
+ * @return The name of the implementation in use: "avx2", "sse2" or "scalar"
+ */
+const char* ScanKernels::implementation() {
+    return kernels().name;
+}
@@ -0,0 +1,47 @@
+// File: ScanKernels.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines the vectorized byte scans behind ArrayBox lookups
+
+#pragma once
+
+/**
+ * @class ScanKernels
+ * @brief Finds and counts bytes equal to a value, and masks bytes within a range, 16 (SSE2) or 32 (AVX2) bytes per compare.
+ * 
+ * The best implementation the CPU supports is picked the first time a kernel is called, 
+ * falling back to a plain loop on CPUs (or compilers) without SSE2 / AVX2.
+ */
+class ScanKernels {
+    public:
+        /**
+         * @param data The bytes to search
+         * @param length The number of bytes to search
+         * @param value The byte to search for
+         * @return The index of the first byte equal to value, or -1 if there is none
+         */
+        static int find(const unsigned char* data, int length, unsigned char value);
+
+        /**
+         * @param data The bytes to search
+         * @param length The number of bytes to search
+         * @param value The byte to count
+         * @return The number of bytes equal to value
+         */
+        static int count(const unsigned char* data, int length, unsigned char value);
+
+        /**
+         * @brief Clears every byte of mask whose byte in data is outside [low, high], leaving the others as they were.
+         *      Applying it once per condition to a mask that starts as all 0xFF leaves 0xFF exactly where every condition holds.
+         * @param data The bytes to test
+         * @param length The number of bytes to test
+         * @param low, high The range of values that keep their mask byte. If low > high, every byte of mask is cleared.
+         * @param mask The bytes to clear, parallel to data
+         */
+        static void maskInRange(const unsigned char* data, int length, unsigned char low, unsigned char high, unsigned char* mask);
+
+        /**
+         * @return The name of the implementation in use: "avx2", "sse2" or "scalar"
+         */
+        static const char* implementation();
+};
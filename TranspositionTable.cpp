@@ -0,0 +1,103 @@
+// File: TranspositionTable.cpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A source files that defines TranspositionTable
+
+#include "TranspositionTable.hpp"
+
+static_assert(sizeof(TranspositionTable::Entry) * TranspositionTable::BUCKET_ENTRIES <= 64, "A bucket must fit in one cache line");
+
+/**
+ * @brief Parameterized constructor. Allocates the whole table up front.
+ * @param megabytes The most memory the table may use. It uses the largest power-of-two number of buckets that fits, 
+ *      and at least one bucket. Default 16.
+ * @param policy How store() picks an entry to overwrite. Default Replacement::DEPTH.
+ */
+TranspositionTable::TranspositionTable(std::size_t megabytes, Replacement policy) : policy_{policy}, age_{0} {
+    std::size_t fits = megabytes * 1024 * 1024 / sizeof(Bucket);
+    std::size_t buckets = 1;
+    while (buckets * 2 <= fits) { buckets *= 2; }
+
+    buckets_.resize(buckets);
+    mask_ = buckets - 1;
+    clear();
+}
+
+/**
+ * @brief Looks a position up
+ * @param key The position's hash
+ * @return A pointer to the position's entry, or nullptr if it is not in the table. 
+ *      Check the entry's depth before using its value. The pointer is invalidated by the next store() or clear().
+ */
+const TranspositionTable::Entry* TranspositionTable::probe(uint64_t key) const {
+    const Bucket& bucket = buckets_[key & mask_];
+    for (int i = 0; i < BUCKET_ENTRIES; i++) {
+        if (bucket.entries[i].depth >= 0 && bucket.entries[i].key == key) { return &bucket.entries[i]; }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Stores a value for a position, replacing the position's old entry if it has one
+ * @param key The position's hash
+ * @param depth The depth the value was computed to (non-negative)
+ * @param value The value to store
+ */
+void TranspositionTable::store(uint64_t key, int depth, uint64_t value) {
+    Bucket& bucket = buckets_[key & mask_];
+
+    // The position's own entry, then an empty one, then whichever the policy gives up
+    int victim = -1;
+    for (int i = 0; i < BUCKET_ENTRIES && victim == -1; i++) {
+        if (bucket.entries[i].depth >= 0 && bucket.entries[i].key == key) { victim = i; }
+    }
+    for (int i = 0; i < BUCKET_ENTRIES && victim == -1; i++) {
+        if (bucket.entries[i].depth < 0) { victim = i; }
+    }
+    if (victim == -1) {
+        victim = BUCKET_ENTRIES - 1;   // The least recently written, for Replacement::ALWAYS
+        if (policy_ != Replacement::ALWAYS) {
+            for (int i = BUCKET_ENTRIES - 1; i >= 0; i--) {
+                const Entry& entry = bucket.entries[i];
+                const Entry& best = bucket.entries[victim];
+                bool older = policy_ == Replacement::AGE_THEN_DEPTH && entry.age != age_;
+                bool bestOlder = policy_ == Replacement::AGE_THEN_DEPTH && best.age != age_;
+                if (older != bestOlder ? older : entry.depth < best.depth) { victim = i; }
+            }
+        }
+    }
+
+    // Keep the bucket ordered from most to least recently written
+    for (int i = victim; i > 0; i--) { bucket.entries[i] = bucket.entries[i - 1]; }
+    bucket.entries[0] = Entry{key, value, depth, age_};
+}
+
+/**
+ * @brief Marks the start of a new search, so Replacement::AGE_THEN_DEPTH prefers to overwrite older entries
+ */
+void TranspositionTable::newSearch() {
+    age_++;
+}
+
+/**
+ * @brief Empties every entry. The memory is kept.
+ */
+void TranspositionTable::clear() {
+    for (Bucket& bucket : buckets_) {
+        for (int i = 0; i < BUCKET_ENTRIES; i++) { bucket.entries[i] = Entry{0, 0, -1, 0}; }
+    }
+}
+
+/**
+ * @return The number of entries the table can hold
+ */
+std::size_t TranspositionTable::capacity() const {
+    return buckets_.size() * BUCKET_ENTRIES;
+}
+
+/**
+ * @return The policy store() uses to pick an entry to overwrite
+ */
+TranspositionTable::Replacement TranspositionTable::policy() const {
+    return policy_;
+}
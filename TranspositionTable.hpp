@@ -0,0 +1,95 @@
+// File: TranspositionTable.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines TranspositionTable, a fixed-size cache of values computed for positions
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class TranspositionTable
+ * @brief A fixed-size hash table from a position's Zobrist hash (see Board::hash()) to a value computed for it, 
+ *      so a search that reaches the same position again looks the value up instead of recomputing it.
+ * 
+ * Entries are grouped into buckets of one cache line each, and a position can only live in the bucket picked by 
+ * the low bits of its hash, so every probe() and store() touches exactly one cache line. 
+ * When that bucket is full, the replacement policy picks which entry to overwrite.
+ * The table never grows: its memory is allocated once, by the constructor.
+ */
+class TranspositionTable {
+    public:
+        /**
+         * @brief Which entry store() overwrites when a position's bucket is full
+         */
+        enum class Replacement {
+            ALWAYS,           // The entry written least recently, so the newest positions are always kept
+            DEPTH,            // The entry with the smallest depth, ie. the one that is cheapest to recompute
+            AGE_THEN_DEPTH    // An entry left over from an older search (see newSearch()) if any, otherwise the smallest depth
+        };
+
+        struct Entry {
+            uint64_t key;      // The full hash of the position, to tell apart positions that share a bucket
+            uint64_t value;    // The value stored for the position
+            int32_t depth;     // The depth the value was computed to. -1 if the entry is empty.
+            uint32_t age;      // The search (see newSearch()) that last wrote the entry
+        };
+
+        static const int BUCKET_ENTRIES = 2;   // The entries that fit in one 64-byte cache line
+
+    private:
+        struct alignas(64) Bucket {
+            Entry entries[BUCKET_ENTRIES];     // Most recently written first
+        };
+
+        std::vector<Bucket> buckets_;   // A power-of-two number of buckets
+        uint64_t mask_;                 // buckets_.size() - 1, so a hash's bucket is hash & mask_
+        Replacement policy_;            // How store() picks an entry to overwrite
+        uint32_t age_;                  // The current search, bumped by newSearch()
+
+    public:
+        /**
+         * @brief Parameterized constructor. Allocates the whole table up front.
+         * @param megabytes The most memory the table may use. It uses the largest power-of-two number of buckets that fits, 
+         *      and at least one bucket. Default 16.
+         * @param policy How store() picks an entry to overwrite. Default Replacement::DEPTH.
+         */
+        explicit TranspositionTable(std::size_t megabytes = 16, Replacement policy = Replacement::DEPTH);
+
+        /**
+         * @brief Looks a position up
+         * @param key The position's hash
+         * @return A pointer to the position's entry, or nullptr if it is not in the table. 
+         *      Check the entry's depth before using its value. The pointer is invalidated by the next store() or clear().
+         */
+        const Entry* probe(uint64_t key) const;
+
+        /**
+         * @brief Stores a value for a position, replacing the position's old entry if it has one
+         * @param key The position's hash
+         * @param depth The depth the value was computed to (non-negative)
+         * @param value The value to store
+         */
+        void store(uint64_t key, int depth, uint64_t value);
+
+        /**
+         * @brief Marks the start of a new search, so Replacement::AGE_THEN_DEPTH prefers to overwrite older entries
+         */
+        void newSearch();
+
+        /**
+         * @brief Empties every entry. The memory is kept.
+         */
+        void clear();
+
+        /**
+         * @return The number of entries the table can hold
+         */
+        std::size_t capacity() const;
+
+        /**
+         * @return The policy store() uses to pick an entry to overwrite
+         */
+        Replacement policy() const;
+};
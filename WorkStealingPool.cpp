@@ -0,0 +1,109 @@
+// File: WorkStealingPool.cpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A source files that defines WorkStealingPool
+
+#include "WorkStealingPool.hpp"
+
+/**
+ * @brief Parameterized constructor. Starts the worker threads.
+ * @param threads The number of workers. Values below 1 use 1.
+ */
+WorkStealingPool::WorkStealingPool(int threads) {
+    if (threads < 1) { threads = 1; }
+
+    queues_.reset(new Queue[threads]);
+    for (int worker = 0; worker < threads; worker++) {
+        workers_.emplace_back(&WorkStealingPool::work, this, worker);
+    }
+}
+
+/**
+ * @brief Destructor. Waits for the workers to finish their current task and stops them.
+ */
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& thread : workers_) { thread.join(); }
+}
+
+/**
+ * @brief Runs every task of a batch on the workers, and returns once all of them have finished
+ * @param tasks The tasks to run. Each is called with the index of the worker running it.
+ */
+void WorkStealingPool::run(std::vector<Task> tasks) {
+    if (tasks.empty()) { return; }
+
+    // Deal the tasks out round-robin. Stealing evens out whatever imbalance is left.
+    pending_ = static_cast<int>(tasks.size());
+    for (size_t i = 0; i < tasks.size(); i++) {
+        Queue& queue = queues_[i % workers_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(tasks[i]));
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    batch_++;
+    wake_.notify_all();
+    done_.wait(lock, [this] { return pending_ == 0; });
+}
+
+/**
+ * @return The number of workers
+ */
+int WorkStealingPool::size() const {
+    return static_cast<int>(workers_.size());
+}
+
+/**
+ * @brief The loop each worker thread runs until the pool is destroyed
+ * @param worker The index of the worker
+ */
+void WorkStealingPool::work(int worker) {
+    unsigned seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this, seen] { return stopping_ || batch_ != seen; });
+            if (stopping_) { return; }
+            seen = batch_;
+        }
+
+        Task task;
+        while (next(worker, task)) {
+            task(worker);
+            if (--pending_ == 0) {
+                // Taking the lock means run() is either before its check or already waiting, so it cannot miss this
+                std::lock_guard<std::mutex> lock(mutex_);
+                done_.notify_all();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Takes the worker's next task: the back of its own queue, or else the front of another worker's
+ * @return True if a task was taken. False if every queue is empty.
+ */
+bool WorkStealingPool::next(int worker, Task& task) {
+    int workers = size();
+    for (int i = 0; i < workers; i++) {
+        int victim = (worker + i) % workers;
+        Queue& queue = queues_[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) { continue; }
+
+        if (victim == worker) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,84 @@
+// File: WorkStealingPool.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines WorkStealingPool, a fixed set of worker threads that share batches of tasks
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Runs batches of independent tasks on a fixed set of worker threads.
+ * 
+ * run() deals a batch's tasks out to one queue per worker. Each worker takes tasks from the back of its own queue, 
+ * and once that is empty, steals from the front of the other workers' queues, so a worker that drew cheap tasks 
+ * helps the others instead of idling. The threads are started once, by the constructor, and sleep between batches.
+ * 
+ * Every task is told which worker runs it, so it can use per-worker state (a copy of the position, counters, ...) 
+ * without any locking. Merge that state after run() returns.
+ */
+class WorkStealingPool {
+    public:
+        using Task = std::function<void(int worker)>;
+
+    private:
+        struct alignas(64) Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::unique_ptr<Queue[]> queues_;   // One per worker
+        std::vector<std::thread> workers_;
+
+        std::mutex mutex_;                  // Guards batch_ and stopping_
+        std::condition_variable wake_;      // Signalled when a batch starts, or the pool stops
+        std::condition_variable done_;      // Signalled when the last task of a batch finishes
+        unsigned batch_ = 0;                // Bumped by every run(), so sleeping workers know there is work
+        bool stopping_ = false;             // Set by the destructor
+        std::atomic<int> pending_{0};       // The tasks of the current batch that have not finished
+
+        /**
+         * @brief The loop each worker thread runs until the pool is destroyed
+         * @param worker The index of the worker
+         */
+        void work(int worker);
+
+        /**
+         * @brief Takes the worker's next task: the back of its own queue, or else the front of another worker's
+         * @return True if a task was taken. False if every queue is empty.
+         */
+        bool next(int worker, Task& task);
+
+    public:
+        /**
+         * @brief Parameterized constructor. Starts the worker threads.
+         * @param threads The number of workers. Values below 1 use 1.
+         */
+        explicit WorkStealingPool(int threads);
+
+        /**
+         * @brief Destructor. Waits for the workers to finish their current task and stops them.
+         */
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        /**
+         * @brief Runs every task of a batch on the workers, and returns once all of them have finished
+         * @param tasks The tasks to run. Each is called with the index of the worker running it.
+         */
+        void run(std::vector<Task> tasks);
+
+        /**
+         * @return The number of workers
+         */
+        int size() const;
+};
@@ -0,0 +1,58 @@
+// File: Zobrist.hpp
+// Author: Tahfizur Rahman 
+// Date: 10/16/2026
+// A header files that defines the Zobrist keys used to hash a Board
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @struct Zobrist
+ * @brief The random 64-bit keys a position's Zobrist hash is built from.
+ * 
+ * A position's hash is the XOR of one key per fact about it: which player's piece of which type stands on 
+ * each square, and whether that piece is moving up, can double jump, or has castle moves left.
+ * Since XOR undoes itself, adding or removing a fact updates the hash in O(1): hash ^= key.
+ * 
+ * The keys are derived from their arguments with the splitmix64 finalizer, so they are the same on every run 
+ * and can be computed by the compiler. Board.cpp tables the ones it uses on every move.
+ */
+struct Zobrist {
+    /**
+     * @brief The splitmix64 finalizer: scrambles a 64-bit value so nearby inputs give unrelated outputs
+     */
+    static constexpr uint64_t mix(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @return The key for a piece of the given player and type standing on the given square
+     */
+    static constexpr uint64_t piece(int player, int typeId, int square) {
+        return mix((uint64_t{1} << 60) | (static_cast<uint64_t>(player) << 40) | (static_cast<uint64_t>(typeId) << 8) | static_cast<uint64_t>(square));
+    }
+
+    /**
+     * @return The key for the piece on the given square moving up the board
+     */
+    static constexpr uint64_t movingUp(int square) {
+        return mix((uint64_t{2} << 60) | static_cast<uint64_t>(square));
+    }
+
+    /**
+     * @return The key for the piece on the given square being able to double jump
+     */
+    static constexpr uint64_t doubleJump(int square) {
+        return mix((uint64_t{3} << 60) | static_cast<uint64_t>(square));
+    }
+
+    /**
+     * @return The key for the piece on the given square having the given number of castle moves left. 0 when it has none.
+     */
+    static constexpr uint64_t castleMoves(int square, int castleMoves) {
+        return castleMoves <= 0 ? 0 : mix((uint64_t{4} << 60) | (static_cast<uint64_t>(castleMoves) << 8) | static_cast<uint64_t>(square));
+    }
+};
@@ -1,10 +1,123 @@
 #include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
 #include "ChessPiece.hpp"
 #include "Pawn.hpp"
 #include "Rook.hpp"
 #include "ChessBox.hpp"
+#include "MoveGenerator.hpp"
+#include "FenStream.hpp"
+#include "BoxStats.hpp"
+
+/**
+ * @brief Prints the work counted since the last reset to stderr, per call where the count belongs to a call.
+ *      Prints nothing when built without CHESSBOX_STATS.
+ */
+static void reportStats() {
+    if (!BoxStats::ENABLED) { return; }
+
+    BoxStats stats = BoxStats::read();
+    auto per = [](uint64_t count, uint64_t calls) { return calls > 0 ? static_cast<double>(count) / calls : 0.0; };
+    std::cerr << "box stats: " << stats.searches << " searches (" << per(stats.cellsProbed, stats.searches) << " cells probed each), "
+              << stats.removes << " removes (" << per(stats.cellsShifted, stats.removes) << " cells shifted each), "
+              << stats.defaultsWritten << " default cells written, " << stats.failedAdds << " failed adds, "
+              << stats.pieceCopies << " piece box copies, " << stats.unshares << " unshares" << std::endl;
+}
+
+/**
+ * @brief Counts the leaf nodes of the game tree from the starting position (see MoveGenerator::startPosition),
+ *      for every depth up to the given one, with P1 moving first. Reports the count, time and nodes per second of each depth.
+ * @param maxDepth The deepest depth to count
+ * @param threads The number of worker threads to count on. 1 counts on the calling thread.
+ * @return The process exit code
+ */
+static int runPerft(int maxDepth, int threads) {
+    ChessBox box = MoveGenerator::startPosition();
+    std::unique_ptr<WorkStealingPool> pool;
+    if (threads > 1) { pool.reset(new WorkStealingPool(threads)); }
+
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t nodes = pool ? MoveGenerator::perft(box, 0, depth, *pool) : MoveGenerator::perft(box, 0, depth);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        double seconds = elapsed.count();
+        std::cout << "perft(" << depth << ") = " << nodes << " nodes in " << seconds * 1000 << " ms ("
+                  << static_cast<uint64_t>(seconds > 0 ? nodes / seconds : 0) << " nodes/sec)" << std::endl;
+    }
+    reportStats();
+    return 0;
+}
+
+/**
+ * @brief Reads every position of a FEN-like file (see FenStream.hpp) into one reusable ChessBox,
+ *      optionally writing each one back out, and reports how many positions were read per second.
+ * @param input The path of the file to read, or "-" for stdin
+ * @param output The path of the file to write the positions to, or "" to not write them
+ * @return The process exit code
+ */
+static int runFenImport(const std::string& input, const std::string& output) {
+    std::unique_ptr<FenReader> reader(input == "-" ? new FenReader(stdin) : new FenReader(input));
+    std::unique_ptr<FenWriter> writer;
+    if (!output.empty()) { writer.reset(output == "-" ? new FenWriter(stdout) : new FenWriter(output)); }
+    if (!reader->isOpen() || (writer && !writer->isOpen())) {
+        std::cerr << "cannot open " << (reader->isOpen() ? output : input) << std::endl;
+        return 1;
+    }
+
+    ChessBox box;
+    uint64_t written = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (reader->next(box)) {
+        if (writer && writer->write(box)) { written++; }
+    }
+    if (writer) { writer->flush(); }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double seconds = elapsed.count();
+    uint64_t positions = reader->positions();
+    std::cerr << "imported " << positions << " positions (" << reader->skipped() << " skipped";
+    if (writer) { std::cerr << ", " << written << " written"; }
+    std::cerr << ") in " << seconds * 1000 << " ms (" 
+              << static_cast<uint64_t>(seconds > 0 ? positions / seconds : 0) << " positions/sec)" << std::endl;
+    reportStats();
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // ./main perft [depth] [--threads N] runs the perft benchmark instead of the tests below
+    if (argc >= 2 && std::string(argv[1]) == "perft") {
+        int depth = 4, threads = 1;
+        bool valid = true;
+        for (int i = 2; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--threads" && i + 1 < argc) { 
+                threads = std::atoi(argv[++i]); 
+                valid = valid && threads >= 1;
+            } else {
+                depth = std::atoi(arg.c_str());
+                valid = valid && depth >= 1 && depth <= MoveJournal::CAPACITY;
+            }
+        }
+        if (!valid) {
+            std::cerr << "usage: " << argv[0] << " perft [depth in 1.." << MoveJournal::CAPACITY << "] [--threads N]" << std::endl;
+            return 1;
+        }
+        return runPerft(depth, threads);
+    }
+
+    // ./main fen <file | -> [--out <file | ->] imports a file of positions and reports the import rate
+    if (argc >= 2 && std::string(argv[1]) == "fen") {
+        bool valid = argc == 3 || (argc == 5 && std::string(argv[3]) == "--out");
+        if (!valid) {
+            std::cerr << "usage: " << argv[0] << " fen <file | -> [--out <file | ->]" << std::endl;
+            return 1;
+        }
+        return runFenImport(argv[2], argc == 5 ? argv[4] : "");
+    }
 
-int main() {
     // Test ChessPiece
     ChessPiece piece1("WHITE", 0, 0, true);
     piece1.display();
@@ -36,8 +149,8 @@ int main() {
     std::cout << "P2 Color: " << chessBox.getP2Color() << std::endl;
 
     // Display pieces in ChessBox
-    std::cout << "P1 Pieces: " << chessBox.getP1Pieces().size() << std::endl;
-    std::cout << "P2 Pieces: " << chessBox.getP2Pieces().size() << std::endl;
+    std::cout << "P1 Pieces: " << chessBox.viewP1Pieces().size() << std::endl;
+    std::cout << "P2 Pieces: " << chessBox.viewP2Pieces().size() << std::endl;
 
     // Test contains function
     std::cout << "ChessBox contains BLACK PAWN: " << chessBox.contains("PAWN", "BLACK") << std::endl;
@@ -45,10 +158,10 @@ int main() {
 
     // Test remove function
     chessBox.removePiece("PAWN", "BLACK");
-    std::cout << "After removing BLACK PAWN, P1 Pieces: " << chessBox.getP1Pieces().size() << std::endl;
+    std::cout << "After removing BLACK PAWN, P1 Pieces: " << chessBox.viewP1Pieces().size() << std::endl;
 
     chessBox.removePiece("ROOK", "WHITE");
-    std::cout << "After removing WHITE ROOK, P2 Pieces: " << chessBox.getP2Pieces().size() << std::endl;
+    std::cout << "After removing WHITE ROOK, P2 Pieces: " << chessBox.viewP2Pieces().size() << std::endl;
 
     return 0;
 }
\ No newline at end of file